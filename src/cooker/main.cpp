@@ -0,0 +1,73 @@
+#include "main.hpp"
+#include "tools_runtime.hpp"
+
+int
+main(int argc, char** argv)
+{
+    using namespace nd::src::tools;
+    using namespace nd::src::graphics;
+    using namespace nd::src::cooker;
+
+    if(argc < 3)
+    {
+        spdlog::error("usage: {} <output.ndm> <input.obj|input.ply>...", argv[0]);
+
+        return 1;
+    }
+
+    Scope::set(shared<logger>(new logger(logScopeName)));
+
+    const auto cacheSize        = 16;
+    const auto lodCount         = 4;
+    const auto lodRatio         = 0.5f;
+    const auto meshletVertices  = 64;
+    const auto meshletTriangles = 124;
+
+    auto meshes = vec<Mesh> {};
+
+    for(auto index = 2; index < argc; ++index)
+    {
+        const auto imported = getMeshImported(argv[index]);
+
+        if(!imported.has_value())
+        {
+            spdlog::error("{}: a face names a vertex the file does not have", argv[index]);
+
+            return 1;
+        }
+
+        const auto& mesh      = imported.value();
+        auto        optimized = getMeshOptimized(mesh, cacheSize);
+
+        optimized.lods     = getMeshLods(optimized, lodCount, lodRatio, cacheSize);
+        optimized.meshlets = getMeshlets(optimized, meshletVertices, meshletTriangles);
+
+        const auto statsBefore = getMeshCacheStats(mesh, cacheSize);
+        const auto statsAfter  = getMeshCacheStats(optimized, cacheSize);
+
+        spdlog::info("{}: {} vertices -> {}, {} triangles, acmr {:.3f} -> {:.3f}, atvr {:.3f} -> {:.3f}, {} lods, {} meshlets",
+                     argv[index],
+                     mesh.vertices.size(),
+                     optimized.vertices.size(),
+                     optimized.indices.size() / 3,
+                     statsBefore.acmr,
+                     statsAfter.acmr,
+                     statsBefore.atvr,
+                     statsAfter.atvr,
+                     optimized.lods.size(),
+                     optimized.meshlets.size());
+
+        for(const auto& lod: optimized.lods)
+        {
+            spdlog::info("    {} triangles, error {:.5f}", lod.indices.size() / 3, lod.error);
+        }
+
+        meshes.push_back(std::move(optimized));
+    }
+
+    setMeshFile(argv[1], meshes, vulkan::vertexFormat);
+
+    spdlog::info("{}: {} meshes", argv[1], meshes.size());
+
+    return 0;
+}
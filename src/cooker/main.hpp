@@ -0,0 +1,16 @@
+#pragma once
+
+#include "tools.hpp"
+
+// nd::src::graphics
+
+#include "mesh_file.hpp"
+#include "mesh_optimizer.hpp"
+#include "mesh_simplifier.hpp"
+#include "mesh_cluster.hpp"
+
+// nd::src::cooker
+
+#include "mesh_import.hpp"
+
+#include <spdlog/spdlog.h>
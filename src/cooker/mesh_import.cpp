@@ -0,0 +1,321 @@
+#include "mesh_import.hpp"
+#include "tools_runtime.hpp"
+
+namespace nd::src::cooker
+{
+    using namespace nd::src::tools;
+
+    using nd::src::graphics::Index;
+    using nd::src::graphics::Mesh;
+    using nd::src::graphics::Vertex;
+
+    struct PlyProperty final
+    {
+        str name;
+        str type;
+        str countType;
+    };
+
+    struct PlyElement final
+    {
+        str name;
+        u64 count;
+
+        vec<PlyProperty> properties;
+    };
+
+    u64
+    getPlySize(const str_v type) noexcept(ND_ASSERT_NOTHROW)
+    {
+        if(type == "char" || type == "uchar" || type == "int8" || type == "uint8")
+        {
+            return 1;
+        }
+
+        if(type == "short" || type == "ushort" || type == "int16" || type == "uint16")
+        {
+            return 2;
+        }
+
+        if(type == "int" || type == "uint" || type == "int32" || type == "uint32" || type == "float" || type == "float32")
+        {
+            return 4;
+        }
+
+        ND_ASSERT(type == "double" || type == "float64");
+
+        return 8;
+    }
+
+    template<typename Type>
+    f64
+    getPlyValue(const array<char, 8>& bytes) noexcept
+    {
+        auto value = Type {};
+
+        std::memcpy(&value, bytes.data(), sizeof(Type));
+
+        return static_cast<f64>(value);
+    }
+
+    f64
+    getPlyValue(std::istream& stream, const str_v type, const bool binary) noexcept(ND_ASSERT_NOTHROW)
+    {
+        if(!binary)
+        {
+            auto value = f64 {};
+
+            stream >> value;
+
+            return value;
+        }
+
+        auto bytes = array<char, 8> {};
+
+        stream.read(bytes.data(), getPlySize(type));
+
+        if(type == "char" || type == "int8")
+        {
+            return getPlyValue<i8>(bytes);
+        }
+
+        if(type == "uchar" || type == "uint8")
+        {
+            return getPlyValue<u8>(bytes);
+        }
+
+        if(type == "short" || type == "int16")
+        {
+            return getPlyValue<i16>(bytes);
+        }
+
+        if(type == "ushort" || type == "uint16")
+        {
+            return getPlyValue<u16>(bytes);
+        }
+
+        if(type == "int" || type == "int32")
+        {
+            return getPlyValue<i32>(bytes);
+        }
+
+        if(type == "uint" || type == "uint32")
+        {
+            return getPlyValue<u32>(bytes);
+        }
+
+        if(type == "float" || type == "float32")
+        {
+            return getPlyValue<f32>(bytes);
+        }
+
+        return getPlyValue<f64>(bytes);
+    }
+
+    void
+    setMeshFace(Mesh& mesh, const vec<Index>& face) noexcept
+    {
+        for(u64 corner = 2; corner < face.size(); ++corner)
+        {
+            mesh.indices.insert(mesh.indices.end(), {face[0], face[corner - 1], face[corner]});
+        }
+    }
+
+    bool
+    isMeshImportValid(const Mesh& mesh) noexcept
+    {
+        return std::all_of(mesh.indices.begin(),
+                           mesh.indices.end(),
+                           [&mesh](const auto index)
+                           {
+                               return index < mesh.vertices.size();
+                           });
+    }
+
+    Mesh
+    getMeshObj(const str& path) noexcept(ND_ASSERT_NOTHROW)
+    {
+        ND_SET_SCOPE();
+
+        auto stream = std::ifstream(path);
+
+        ND_ASSERT(stream.is_open());
+
+        auto mesh = Mesh {};
+        auto face = vec<Index> {};
+        auto line = str {};
+
+        while(std::getline(stream, line))
+        {
+            auto tokens = std::istringstream(line);
+            auto type   = str {};
+
+            tokens >> type;
+
+            if(type == "v")
+            {
+                auto vertex = Vertex {.position = glm::vec3(0.0f), .color = glm::vec3(1.0f)};
+
+                tokens >> vertex.position.x >> vertex.position.y >> vertex.position.z;
+
+                if(!(tokens >> vertex.color.r >> vertex.color.g >> vertex.color.b))
+                {
+                    vertex.color = glm::vec3(1.0f);
+                }
+
+                mesh.vertices.push_back(vertex);
+            }
+
+            if(type == "f")
+            {
+                face.clear();
+
+                for(auto token = str {}; tokens >> token;)
+                {
+                    const auto index = std::strtoll(token.c_str(), nullptr, 10);
+
+                    face.push_back(static_cast<Index>(index < 0 ? static_cast<i64>(mesh.vertices.size()) + index : index - 1));
+                }
+
+                setMeshFace(mesh, face);
+            }
+        }
+
+        return mesh;
+    }
+
+    Mesh
+    getMeshPly(const str& path) noexcept(ND_ASSERT_NOTHROW)
+    {
+        ND_SET_SCOPE();
+
+        auto stream = std::ifstream(path, std::ios::binary);
+
+        ND_ASSERT(stream.is_open());
+
+        auto elements = vec<PlyElement> {};
+        auto format   = str {};
+        auto line     = str {};
+
+        std::getline(stream, line);
+
+        ND_ASSERT(line.starts_with("ply"));
+
+        while(std::getline(stream, line) && !line.starts_with("end_header"))
+        {
+            auto tokens = std::istringstream(line);
+            auto type   = str {};
+
+            tokens >> type;
+
+            if(type == "format")
+            {
+                tokens >> format;
+            }
+
+            if(type == "element")
+            {
+                auto& element = elements.emplace_back();
+
+                tokens >> element.name >> element.count;
+            }
+
+            if(type == "property")
+            {
+                ND_ASSERT(!elements.empty());
+
+                auto& property = elements.back().properties.emplace_back();
+
+                tokens >> property.type;
+
+                if(property.type == "list")
+                {
+                    tokens >> property.countType >> property.type;
+                }
+
+                tokens >> property.name;
+            }
+        }
+
+        const auto binary = format == "binary_little_endian";
+
+        ND_ASSERT(binary || format == "ascii");
+        ND_ASSERT(!binary || std::endian::native == std::endian::little);
+
+        auto mesh = Mesh {};
+        auto face = vec<Index> {};
+
+        for(const auto& element: elements)
+        {
+            for(u64 index = 0; index < element.count; ++index)
+            {
+                auto vertex = Vertex {.position = glm::vec3(0.0f), .color = glm::vec3(1.0f)};
+
+                face.clear();
+
+                for(const auto& property: element.properties)
+                {
+                    if(!property.countType.empty())
+                    {
+                        const auto count = static_cast<u64>(getPlyValue(stream, property.countType, binary));
+
+                        for(u64 item = 0; item < count; ++item)
+                        {
+                            const auto value = static_cast<Index>(static_cast<i64>(getPlyValue(stream, property.type, binary)));
+
+                            if(property.name == "vertex_indices" || property.name == "vertex_index")
+                            {
+                                face.push_back(value);
+                            }
+                        }
+
+                        continue;
+                    }
+
+                    const auto value = static_cast<f32>(getPlyValue(stream, property.type, binary));
+                    const auto color = getPlySize(property.type) == 1 ? value / 255.0f : value;
+
+                    const auto& name = property.name;
+
+                    vertex.position.x = name == "x" ? value : vertex.position.x;
+                    vertex.position.y = name == "y" ? value : vertex.position.y;
+                    vertex.position.z = name == "z" ? value : vertex.position.z;
+                    vertex.color.r    = name == "red" ? color : vertex.color.r;
+                    vertex.color.g    = name == "green" ? color : vertex.color.g;
+                    vertex.color.b    = name == "blue" ? color : vertex.color.b;
+                }
+
+                if(element.name == "vertex")
+                {
+                    mesh.vertices.push_back(vertex);
+                }
+
+                if(element.name == "face")
+                {
+                    setMeshFace(mesh, face);
+                }
+            }
+        }
+
+        return mesh;
+    }
+
+    std::optional<Mesh>
+    getMeshImported(const str& path) noexcept(ND_ASSERT_NOTHROW)
+    {
+        ND_SET_SCOPE();
+
+        const auto extension = std::filesystem::path(path).extension();
+
+        ND_ASSERT(extension == ".obj" || extension == ".ply");
+
+        auto mesh = extension == ".obj" ? getMeshObj(path) : getMeshPly(path);
+
+        if(!isMeshImportValid(mesh))
+        {
+            return std::nullopt;
+        }
+
+        return mesh;
+    }
+} // namespace nd::src::cooker
@@ -0,0 +1,20 @@
+#pragma once
+
+#include "pch.hpp"
+#include "tools.hpp"
+
+// nd::src::graphics
+
+#include "scene.hpp"
+
+namespace nd::src::cooker
+{
+    graphics::Mesh
+    getMeshObj(const str&) noexcept(ND_ASSERT_NOTHROW);
+
+    graphics::Mesh
+    getMeshPly(const str&) noexcept(ND_ASSERT_NOTHROW);
+
+    std::optional<graphics::Mesh>
+    getMeshImported(const str&) noexcept(ND_ASSERT_NOTHROW);
+} // namespace nd::src::cooker
@@ -0,0 +1,209 @@
+#include "frustum_cull.hpp"
+#include "tools_runtime.hpp"
+
+#if defined(__x86_64__) || defined(__i386__)
+    #include <immintrin.h>
+#endif
+
+namespace nd::src::graphics
+{
+    using namespace nd::src::tools;
+
+    using FrustumKernel = u64 (*)(const FrustumSpheres&, const array<glm::vec4, 6>&, u32*) noexcept;
+
+    u64
+    getFrustumVisibleScalar(const FrustumSpheres& spheres, const array<glm::vec4, 6>& planes, const u64 first, u32* visible) noexcept
+    {
+        auto count = u64 {0};
+
+        for(u64 index = first; index < spheres.radius.size(); ++index)
+        {
+            auto inside = true;
+
+            for(const auto& plane: planes)
+            {
+                inside &= plane.x * spheres.x[index] + plane.y * spheres.y[index] + plane.z * spheres.z[index] + plane.w >= -spheres.radius[index];
+            }
+
+            visible[count] = static_cast<u32>(index);
+            count += inside;
+        }
+
+        return count;
+    }
+
+    u64
+    getFrustumVisibleScalar(const FrustumSpheres& spheres, const array<glm::vec4, 6>& planes, u32* visible) noexcept
+    {
+        return getFrustumVisibleScalar(spheres, planes, 0, visible);
+    }
+
+#if defined(__x86_64__) || defined(__i386__)
+    u64
+    setFrustumVisibleMask(u32 mask, const u64 first, u32* visible) noexcept
+    {
+        auto count = u64 {0};
+
+        while(mask)
+        {
+            visible[count++] = static_cast<u32>(first + std::countr_zero(mask));
+
+            mask &= mask - 1;
+        }
+
+        return count;
+    }
+
+    __attribute__((target("avx2,fma"))) u64
+    getFrustumVisibleAvx2(const FrustumSpheres& spheres, const array<glm::vec4, 6>& planes, u32* visible) noexcept
+    {
+        const auto size = spheres.radius.size() / 8 * 8;
+
+        auto count = u64 {0};
+
+        for(u64 index = 0; index < size; index += 8)
+        {
+            const auto x      = _mm256_loadu_ps(spheres.x.data() + index);
+            const auto y      = _mm256_loadu_ps(spheres.y.data() + index);
+            const auto z      = _mm256_loadu_ps(spheres.z.data() + index);
+            const auto radius = _mm256_sub_ps(_mm256_setzero_ps(), _mm256_loadu_ps(spheres.radius.data() + index));
+
+            auto inside = _mm256_castsi256_ps(_mm256_set1_epi32(-1));
+
+            for(const auto& plane: planes)
+            {
+                auto distance = _mm256_set1_ps(plane.w);
+
+                distance = _mm256_fmadd_ps(_mm256_set1_ps(plane.z), z, distance);
+                distance = _mm256_fmadd_ps(_mm256_set1_ps(plane.y), y, distance);
+                distance = _mm256_fmadd_ps(_mm256_set1_ps(plane.x), x, distance);
+
+                inside = _mm256_and_ps(inside, _mm256_cmp_ps(distance, radius, _CMP_GE_OQ));
+            }
+
+            count += setFrustumVisibleMask(static_cast<u32>(_mm256_movemask_ps(inside)), index, visible + count);
+        }
+
+        return count + getFrustumVisibleScalar(spheres, planes, size, visible + count);
+    }
+
+    __attribute__((target("sse"))) u64
+    getFrustumVisibleSse(const FrustumSpheres& spheres, const array<glm::vec4, 6>& planes, u32* visible) noexcept
+    {
+        const auto size = spheres.radius.size() / 4 * 4;
+
+        auto count = u64 {0};
+
+        for(u64 index = 0; index < size; index += 4)
+        {
+            const auto x      = _mm_loadu_ps(spheres.x.data() + index);
+            const auto y      = _mm_loadu_ps(spheres.y.data() + index);
+            const auto z      = _mm_loadu_ps(spheres.z.data() + index);
+            const auto radius = _mm_sub_ps(_mm_setzero_ps(), _mm_loadu_ps(spheres.radius.data() + index));
+
+            auto inside = _mm_cmpeq_ps(_mm_setzero_ps(), _mm_setzero_ps());
+
+            for(const auto& plane: planes)
+            {
+                auto distance = _mm_set1_ps(plane.w);
+
+                distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.z), z));
+                distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.y), y));
+                distance = _mm_add_ps(distance, _mm_mul_ps(_mm_set1_ps(plane.x), x));
+
+                inside = _mm_and_ps(inside, _mm_cmpge_ps(distance, radius));
+            }
+
+            count += setFrustumVisibleMask(static_cast<u32>(_mm_movemask_ps(inside)), index, visible + count);
+        }
+
+        return count + getFrustumVisibleScalar(spheres, planes, size, visible + count);
+    }
+#endif
+
+    FrustumKernel
+    getFrustumKernel() noexcept
+    {
+#if defined(__x86_64__) || defined(__i386__)
+        __builtin_cpu_init();
+
+        if(__builtin_cpu_supports("avx2") && __builtin_cpu_supports("fma"))
+        {
+            return getFrustumVisibleAvx2;
+        }
+
+        if(__builtin_cpu_supports("sse"))
+        {
+            return getFrustumVisibleSse;
+        }
+#endif
+
+        return getFrustumVisibleScalar;
+    }
+
+    glm::vec3
+    getFrustumCenter(const Transform& transform, const glm::vec3& center) noexcept
+    {
+        const auto scaled = transform.scalation * center;
+
+        const auto [sinX, cosX] = std::pair {std::sin(transform.rotation.x), std::cos(transform.rotation.x)};
+        const auto [sinY, cosY] = std::pair {std::sin(transform.rotation.y), std::cos(transform.rotation.y)};
+        const auto [sinZ, cosZ] = std::pair {std::sin(transform.rotation.z), std::cos(transform.rotation.z)};
+
+        const auto rotatedX = glm::vec3(scaled.x, scaled.y * cosX - scaled.z * sinX, scaled.y * sinX + scaled.z * cosX);
+        const auto rotatedY = glm::vec3(rotatedX.x * cosY + rotatedX.z * sinY, rotatedX.y, rotatedX.z * cosY - rotatedX.x * sinY);
+        const auto rotatedZ = glm::vec3(rotatedY.x * cosZ - rotatedY.y * sinZ, rotatedY.x * sinZ + rotatedY.y * cosZ, rotatedY.z);
+
+        return transform.translation + rotatedZ;
+    }
+
+    FrustumSpheres
+    getFrustumSpheres(const span<const Instance> instances, const Geometry& geometry) noexcept
+    {
+        ND_SET_SCOPE();
+
+        auto spheres = FrustumSpheres {.x      = vec<f32>(instances.size()),
+                                       .y      = vec<f32>(instances.size()),
+                                       .z      = vec<f32>(instances.size()),
+                                       .radius = vec<f32>(instances.size())};
+
+        for(u64 index = 0; index < instances.size(); ++index)
+        {
+            const auto& instance = instances[index];
+
+            if(!isGeometryResident(geometry, instance.meshIndex))
+            {
+                spheres.radius[index] = -std::numeric_limits<f32>::infinity();
+
+                continue;
+            }
+
+            const auto& mesh      = geometry.meshes[instance.meshIndex];
+            const auto& scalation = instance.transform.scalation;
+
+            const auto scale  = std::max({std::abs(scalation.x), std::abs(scalation.y), std::abs(scalation.z)});
+            const auto center = getFrustumCenter(instance.transform, mesh.center);
+
+            spheres.x[index]      = center.x;
+            spheres.y[index]      = center.y;
+            spheres.z[index]      = center.z;
+            spheres.radius[index] = mesh.radius * scale;
+        }
+
+        return spheres;
+    }
+
+    vec<u32>
+    getFrustumVisible(const FrustumSpheres& spheres, const array<glm::vec4, 6>& planes) noexcept
+    {
+        ND_SET_SCOPE();
+
+        static const auto kernel = getFrustumKernel();
+
+        auto visible = vec<u32>(spheres.radius.size());
+
+        visible.resize(kernel(spheres, planes, visible.data()));
+
+        return visible;
+    }
+} // namespace nd::src::graphics
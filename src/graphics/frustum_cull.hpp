@@ -0,0 +1,25 @@
+#pragma once
+
+#include "pch.hpp"
+#include "tools.hpp"
+
+// nd::src::graphics
+
+#include "geometry.hpp"
+
+namespace nd::src::graphics
+{
+    struct FrustumSpheres final
+    {
+        vec<f32> x;
+        vec<f32> y;
+        vec<f32> z;
+        vec<f32> radius;
+    };
+
+    FrustumSpheres
+    getFrustumSpheres(const span<const Instance>, const Geometry&) noexcept;
+
+    vec<u32>
+    getFrustumVisible(const FrustumSpheres&, const array<glm::vec4, 6>&) noexcept;
+} // namespace nd::src::graphics
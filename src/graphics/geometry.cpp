@@ -0,0 +1,465 @@
+#include "geometry.hpp"
+#include "tools_runtime.hpp"
+
+namespace nd::src::graphics
+{
+    using namespace nd::src::tools;
+
+    using nd::src::graphics::vulkan::getGrowableBuffer;
+    using nd::src::graphics::vulkan::allocateGrowableRange;
+    using nd::src::graphics::vulkan::freeGrowableRange;
+    using nd::src::graphics::vulkan::resetGrowableBuffer;
+    using nd::src::graphics::vulkan::setStagingUpload;
+    using nd::src::graphics::vulkan::setStagingStream;
+
+    using nd::src::graphics::vulkan::VertexFormat;
+
+    void
+    freeGeometryMesh(Geometry& geometry, const GeometryMesh& mesh) noexcept
+    {
+        ND_SET_SCOPE();
+
+        if(mesh.vertexCount)
+        {
+            freeGrowableRange(geometry.buffer, mesh.vertexOffset * getGeometryVertexSize(geometry.format));
+        }
+
+        if(mesh.indexCount)
+        {
+            freeGrowableRange(geometry.buffer, mesh.firstIndex * getGeometryIndexSize(mesh.indexType));
+        }
+
+        if(mesh.meshletCount)
+        {
+            freeGrowableRange(geometry.buffer, mesh.firstMeshlet * sizeof(GeometryMeshlet));
+        }
+    }
+
+    Geometry
+    getGeometry(vulkan::Buffer& buffer, const VertexFormat format, const f32 growth, const u16 frameCount) noexcept
+    {
+        ND_SET_SCOPE();
+
+        return {.buffer = getGrowableBuffer(buffer, growth, frameCount), .format = format, .meshes = {}};
+    }
+
+    glm::mat4
+    getGeometryTransform(const GeometryMesh& mesh) noexcept
+    {
+        ND_SET_SCOPE();
+
+        return glm::scale(glm::translate(glm::mat4(1.0f), mesh.bias), mesh.scale);
+    }
+
+    GeometryLodCfg
+    getGeometryLodCfg(const Camera& camera, const f32 width, const f32 errorMax) noexcept
+    {
+        ND_SET_SCOPE();
+
+        return {.eye        = camera.location,
+                .projection = width / (2.0f * std::tan(glm::radians(camera.fovx) * 0.5f)),
+                .errorMax   = errorMax,
+                .near       = camera.near,
+                .far        = camera.far};
+    }
+
+    u64
+    getGeometryLod(const GeometryMesh& mesh, const GeometryLodCfg& cfg, const glm::vec4& sphere, const f32 scale) noexcept
+    {
+        ND_SET_SCOPE();
+
+        if(mesh.lods.size() < 2)
+        {
+            return 0;
+        }
+
+        const auto distance = std::max(glm::length(glm::vec3(sphere) - cfg.eye) - sphere.w, cfg.near);
+
+        if(distance > cfg.far)
+        {
+            return mesh.lods.size() - 1;
+        }
+
+        auto lod = u64 {0};
+
+        while(lod + 1 < mesh.lods.size() && mesh.lods[lod + 1].error * scale * cfg.projection / distance <= cfg.errorMax)
+        {
+            ++lod;
+        }
+
+        return lod;
+    }
+
+    VkDeviceSize
+    getGeometryVertexSize(const VertexFormat format) noexcept
+    {
+        ND_SET_SCOPE();
+
+        return format == VertexFormat::quantized ? sizeof(VertexQuantized) : sizeof(Vertex);
+    }
+
+    VkDeviceSize
+    getGeometryIndexSize(const VkIndexType type) noexcept
+    {
+        ND_SET_SCOPE();
+
+        return type == VK_INDEX_TYPE_UINT16 ? sizeof(u16) : sizeof(u32);
+    }
+
+    VkIndexType
+    getGeometryIndexType(const Mesh& mesh) noexcept
+    {
+        ND_SET_SCOPE();
+
+        return mesh.vertices.size() <= std::numeric_limits<u16>::max() + 1ULL ? VK_INDEX_TYPE_UINT16 : VK_INDEX_TYPE_UINT32;
+    }
+
+    vec<std::byte>
+    getGeometryIndices(const Mesh& mesh, const VkIndexType type) noexcept
+    {
+        ND_SET_SCOPE();
+
+        auto indices = mesh.indices;
+
+        for(const auto& lod: mesh.lods)
+        {
+            indices.insert(indices.end(), lod.indices.begin(), lod.indices.end());
+        }
+
+        const auto indexData = std::as_bytes(span {indices});
+
+        if(type == VK_INDEX_TYPE_UINT32)
+        {
+            return vec<std::byte>(indexData.begin(), indexData.end());
+        }
+
+        const auto narrowed = getMapped<Index, u16>(indices,
+                                                    [](const auto index, const auto)
+                                                    {
+                                                        return static_cast<u16>(index);
+                                                    });
+
+        const auto narrowedData = std::as_bytes(span {narrowed});
+
+        return vec<std::byte>(narrowedData.begin(), narrowedData.end());
+    }
+
+    vec<GeometryLod>
+    getGeometryLods(const Mesh& mesh) noexcept
+    {
+        ND_SET_SCOPE();
+
+        auto lods = vec<GeometryLod> {{.firstIndex = 0, .indexCount = static_cast<u32>(mesh.indices.size()), .error = 0.0f}};
+
+        for(const auto& lod: mesh.lods)
+        {
+            lods.push_back({.firstIndex = lods.back().firstIndex + lods.back().indexCount,
+                            .indexCount = static_cast<u32>(lod.indices.size()),
+                            .error      = lod.error});
+        }
+
+        return lods;
+    }
+
+    vec<std::byte>
+    getGeometryMeshlets(const Mesh& mesh) noexcept
+    {
+        ND_SET_SCOPE();
+
+        const auto meshlets = getMapped<Meshlet, GeometryMeshlet>(mesh.meshlets,
+                                                                  [](const auto& meshlet, const auto)
+                                                                  {
+                                                                      return GeometryMeshlet {
+                                                                          .sphere     = glm::vec4(meshlet.center, meshlet.radius),
+                                                                          .cone       = glm::vec4(meshlet.coneAxis, meshlet.coneCutoff),
+                                                                          .firstIndex = meshlet.firstIndex,
+                                                                          .indexCount = meshlet.indexCount,
+                                                                          .reserved   = {}};
+                                                                  });
+
+        const auto meshletData = std::as_bytes(span {meshlets});
+
+        return vec<std::byte>(meshletData.begin(), meshletData.end());
+    }
+
+    void
+    setGeometryBounds(GeometryMesh& geometryMesh, const Mesh& mesh) noexcept
+    {
+        ND_SET_SCOPE();
+
+        if(mesh.vertices.empty())
+        {
+            geometryMesh.center = glm::vec3(0.0f);
+            geometryMesh.radius = 0.0f;
+
+            return;
+        }
+
+        auto min = mesh.vertices.front().position;
+        auto max = mesh.vertices.front().position;
+
+        for(const auto& vertex: mesh.vertices)
+        {
+            min = glm::min(min, vertex.position);
+            max = glm::max(max, vertex.position);
+        }
+
+        geometryMesh.center = (max + min) * 0.5f;
+        geometryMesh.radius = 0.0f;
+
+        for(const auto& vertex: mesh.vertices)
+        {
+            geometryMesh.radius = std::max(geometryMesh.radius, glm::length(vertex.position - geometryMesh.center));
+        }
+    }
+
+    vec<std::byte>
+    getGeometryVertices(const Mesh& mesh, const VertexFormat format, GeometryMesh& geometryMesh) noexcept
+    {
+        ND_SET_SCOPE();
+
+        const auto vertexData = std::as_bytes(span {mesh.vertices});
+
+        if(format == VertexFormat::full || mesh.vertices.empty())
+        {
+            geometryMesh.scale = glm::vec3(1.0f);
+            geometryMesh.bias  = glm::vec3(0.0f);
+
+            return vec<std::byte>(vertexData.begin(), vertexData.end());
+        }
+
+        auto min = mesh.vertices.front().position;
+        auto max = mesh.vertices.front().position;
+
+        for(const auto& vertex: mesh.vertices)
+        {
+            min = glm::min(min, vertex.position);
+            max = glm::max(max, vertex.position);
+        }
+
+        geometryMesh.scale = glm::max((max - min) * 0.5f, glm::vec3(std::numeric_limits<f32>::min()));
+        geometryMesh.bias  = (max + min) * 0.5f;
+
+        const auto vertices = getMapped<Vertex, VertexQuantized>(
+            mesh.vertices,
+            [&geometryMesh](const auto& vertex, const auto index)
+            {
+                const auto position = glm::round(glm::clamp((vertex.position - geometryMesh.bias) / geometryMesh.scale, -1.0f, 1.0f) * 32767.0f);
+                const auto color    = glm::round(glm::clamp(vertex.color, 0.0f, 1.0f) * 255.0f);
+
+                return VertexQuantized {
+                    .position = {static_cast<i16>(position.x), static_cast<i16>(position.y), static_cast<i16>(position.z), 0},
+                    .color    = {static_cast<u8>(color.x), static_cast<u8>(color.y), static_cast<u8>(color.z), 255}};
+            });
+
+        const auto verticesData = std::as_bytes(span {vertices});
+
+        return vec<std::byte>(verticesData.begin(), verticesData.end());
+    }
+
+    GeometryData
+    getGeometryData(const Mesh& source, const VertexFormat format) noexcept
+    {
+        ND_SET_SCOPE();
+
+        const auto cacheSize        = 16;
+        const auto lodCount         = 4;
+        const auto lodRatio         = 0.5f;
+        const auto meshletVertices  = 64;
+        const auto meshletTriangles = 124;
+
+        auto mesh = getMeshOptimized(source, cacheSize);
+
+        mesh.lods     = getMeshLods(mesh, lodCount, lodRatio, cacheSize);
+        mesh.meshlets = getMeshlets(mesh, meshletVertices, meshletTriangles);
+
+        if(const auto log = spdlog::get(logMainName); log)
+        {
+            const auto statsBefore = getMeshCacheStats(source, cacheSize);
+            const auto statsAfter  = getMeshCacheStats(mesh, cacheSize);
+
+            log->info("mesh version {}: acmr {:.3f} -> {:.3f}, atvr {:.3f} -> {:.3f}, {} lods, {} meshlets",
+                      source.version,
+                      statsBefore.acmr,
+                      statsAfter.acmr,
+                      statsBefore.atvr,
+                      statsAfter.atvr,
+                      mesh.lods.size(),
+                      mesh.meshlets.size());
+        }
+
+        const auto lods = getGeometryLods(mesh);
+
+        auto data = GeometryData {.mesh        = {.firstIndex   = 0,
+                                                  .vertexOffset = 0,
+                                                  .indexCount   = lods.back().firstIndex + lods.back().indexCount,
+                                                  .vertexCount  = static_cast<u32>(mesh.vertices.size()),
+                                                  .firstMeshlet = 0,
+                                                  .meshletCount = 0,
+                                                  .indexType    = getGeometryIndexType(mesh),
+                                                  .scale        = {},
+                                                  .bias         = {},
+                                                  .center       = {},
+                                                  .radius       = 0.0f,
+                                                  .lods         = lods,
+                                                  .version      = source.version},
+                                  .vertexData  = {},
+                                  .indexData   = {},
+                                  .meshletData = {},
+                                  .vertexView  = {},
+                                  .indexView   = {},
+                                  .meshletView = {}};
+
+        setGeometryBounds(data.mesh, mesh);
+
+        data.vertexData  = getGeometryVertices(mesh, format, data.mesh);
+        data.indexData   = getGeometryIndices(mesh, data.mesh.indexType);
+        data.meshletData = getGeometryMeshlets(mesh);
+
+        return data;
+    }
+
+    GeometryData
+    getGeometryData(const MeshFile& file, const u64 index) noexcept(ND_ASSERT_NOTHROW)
+    {
+        ND_SET_SCOPE();
+
+        ND_ASSERT(index < file.entries.size());
+
+        const auto& entry = file.entries[index];
+
+        const auto lods = getMapped<MeshFileLod, GeometryLod>(span {entry.lods}.first(entry.lodCount),
+                                                              [](const auto& lod, const auto)
+                                                              {
+                                                                  return GeometryLod {.firstIndex = lod.firstIndex,
+                                                                                      .indexCount = lod.indexCount,
+                                                                                      .error      = lod.error};
+                                                              });
+
+        return GeometryData {.mesh        = {.firstIndex   = 0,
+                                             .vertexOffset = 0,
+                                             .indexCount   = entry.indexCount,
+                                             .vertexCount  = entry.vertexCount,
+                                             .firstMeshlet = 0,
+                                             .meshletCount = 0,
+                                             .indexType    = static_cast<VkIndexType>(entry.indexType),
+                                             .scale        = entry.scale,
+                                             .bias         = entry.bias,
+                                             .center       = entry.center,
+                                             .radius       = entry.radius,
+                                             .lods         = lods,
+                                             .version      = 0},
+                             .vertexData  = {},
+                             .indexData   = {},
+                             .meshletData = {},
+                             .vertexView  = getMeshFileVertices(file, entry),
+                             .indexView   = getMeshFileIndices(file, entry),
+                             .meshletView = getMeshFileMeshlets(file, entry)};
+    }
+
+    span<const std::byte>
+    getGeometryBlob(const vec<std::byte>& data, const span<const std::byte> view) noexcept
+    {
+        return view.empty() ? span<const std::byte> {data} : view;
+    }
+
+    VkDeviceSize
+    getGeometryDataSize(const GeometryData& data) noexcept
+    {
+        ND_SET_SCOPE();
+
+        return getGeometryBlob(data.vertexData, data.vertexView).size() + getGeometryBlob(data.indexData, data.indexView).size() +
+               getGeometryBlob(data.meshletData, data.meshletView).size();
+    }
+
+    void
+    setGeometryBlob(vulkan::StagingRing&        ring,
+                    const vulkan::Buffer&       buffer,
+                    const VkDeviceSize          offset,
+                    const vec<std::byte>&       data,
+                    const span<const std::byte> view) noexcept
+    {
+        if(view.empty())
+        {
+            setStagingUpload(ring, buffer, offset, data);
+
+            return;
+        }
+
+        setStagingStream(ring, buffer, offset, view);
+    }
+
+    bool
+    isGeometryResident(const Geometry& geometry, const u64 index) noexcept
+    {
+        ND_SET_SCOPE();
+
+        return index < geometry.meshes.size() && !geometry.meshes[index].lods.empty();
+    }
+
+    GeometryMesh
+    setGeometryData(Geometry&              geometry,
+                    vulkan::StagingRing&   ring,
+                    const GeometryData&    data,
+                    const VkDevice         device,
+                    const VkPhysicalDevice physicalDevice) noexcept(ND_VK_ASSERT_NOTHROW&& ND_ASSERT_NOTHROW)
+    {
+        ND_SET_SCOPE();
+
+        const auto vertexSize  = getGeometryVertexSize(geometry.format);
+        const auto indexSize   = getGeometryIndexSize(data.mesh.indexType);
+        const auto meshletSize = sizeof(GeometryMeshlet);
+
+        const auto vertexData  = getGeometryBlob(data.vertexData, data.vertexView);
+        const auto indexData   = getGeometryBlob(data.indexData, data.indexView);
+        const auto meshletData = getGeometryBlob(data.meshletData, data.meshletView);
+
+        const auto vertexOffset =
+            vertexData.empty() ? 0ULL : allocateGrowableRange(geometry.buffer, ring, vertexData.size(), vertexSize, device, physicalDevice);
+        const auto indexOffset =
+            indexData.empty() ? 0ULL : allocateGrowableRange(geometry.buffer, ring, indexData.size(), indexSize, device, physicalDevice);
+        const auto meshletOffset =
+            meshletData.empty() ? 0ULL : allocateGrowableRange(geometry.buffer, ring, meshletData.size(), meshletSize, device, physicalDevice);
+
+        auto mesh = data.mesh;
+
+        mesh.firstIndex   = static_cast<u32>(indexOffset / indexSize);
+        mesh.vertexOffset = static_cast<i32>(vertexOffset / vertexSize);
+        mesh.firstMeshlet = static_cast<u32>(meshletOffset / meshletSize);
+        mesh.meshletCount = static_cast<u32>(meshletData.size() / meshletSize);
+
+        for(auto& lod: mesh.lods)
+        {
+            lod.firstIndex += mesh.firstIndex;
+        }
+
+        setGeometryBlob(ring, *geometry.buffer.buffer, vertexOffset, data.vertexData, data.vertexView);
+        setGeometryBlob(ring, *geometry.buffer.buffer, indexOffset, data.indexData, data.indexView);
+        setGeometryBlob(ring, *geometry.buffer.buffer, meshletOffset, data.meshletData, data.meshletView);
+
+        return mesh;
+    }
+
+    void
+    setGeometryMesh(Geometry& geometry, const u64 index, const GeometryMesh& mesh) noexcept
+    {
+        ND_SET_SCOPE();
+
+        if(index >= geometry.meshes.size())
+        {
+            geometry.meshes.resize(index + 1, GeometryMesh {});
+        }
+
+        freeGeometryMesh(geometry, geometry.meshes[index]);
+
+        geometry.meshes[index] = mesh;
+    }
+
+    void
+    resetGeometry(Geometry& geometry, const u16 frameIndex, const VkDevice device) noexcept(ND_ASSERT_NOTHROW)
+    {
+        ND_SET_SCOPE();
+
+        resetGrowableBuffer(geometry.buffer, frameIndex, device);
+    }
+} // namespace nd::src::graphics
@@ -0,0 +1,155 @@
+#pragma once
+
+#include "pch.hpp"
+#include "tools.hpp"
+
+// nd::src::graphics::vulkan
+
+#include "objects_complete.hpp"
+
+// nd::src::graphics
+
+#include "scene.hpp"
+#include "mesh_optimizer.hpp"
+#include "mesh_simplifier.hpp"
+#include "mesh_cluster.hpp"
+#include "mesh_file.hpp"
+
+namespace nd::src::graphics
+{
+    struct GeometryLod final
+    {
+        u32 firstIndex;
+        u32 indexCount;
+
+        f32 error;
+    };
+
+    struct GeometryMeshlet final
+    {
+        glm::vec4 sphere;
+        glm::vec4 cone;
+
+        u32 firstIndex;
+        u32 indexCount;
+
+        array<u32, 2> reserved;
+    };
+
+    struct GeometryMesh final
+    {
+        u32 firstIndex;
+        i32 vertexOffset;
+        u32 indexCount;
+        u32 vertexCount;
+        u32 firstMeshlet;
+        u32 meshletCount;
+
+        VkIndexType indexType;
+
+        glm::vec3 scale;
+        glm::vec3 bias;
+        glm::vec3 center;
+
+        f32 radius;
+
+        vec<GeometryLod> lods;
+
+        u64 version;
+    };
+
+    struct GeometryData final
+    {
+        GeometryMesh mesh;
+
+        vec<std::byte> vertexData;
+        vec<std::byte> indexData;
+        vec<std::byte> meshletData;
+
+        span<const std::byte> vertexView;
+        span<const std::byte> indexView;
+        span<const std::byte> meshletView;
+    };
+
+    struct GeometryLodCfg final
+    {
+        glm::vec3 eye;
+
+        f32 projection;
+        f32 errorMax;
+        f32 near;
+        f32 far;
+    };
+
+    struct Geometry final
+    {
+        vulkan::GrowableBuffer buffer;
+        vulkan::VertexFormat   format;
+
+        vec<GeometryMesh> meshes;
+    };
+
+    Geometry
+    getGeometry(vulkan::Buffer&, const vulkan::VertexFormat, const f32, const u16) noexcept;
+
+    glm::mat4
+    getGeometryTransform(const GeometryMesh&) noexcept;
+
+    GeometryLodCfg
+    getGeometryLodCfg(const Camera&, const f32, const f32) noexcept;
+
+    u64
+    getGeometryLod(const GeometryMesh&, const GeometryLodCfg&, const glm::vec4&, const f32) noexcept;
+
+    VkDeviceSize
+    getGeometryVertexSize(const vulkan::VertexFormat) noexcept;
+
+    VkDeviceSize
+    getGeometryIndexSize(const VkIndexType) noexcept;
+
+    VkIndexType
+    getGeometryIndexType(const Mesh&) noexcept;
+
+    vec<std::byte>
+    getGeometryVertices(const Mesh&, const vulkan::VertexFormat, GeometryMesh&) noexcept;
+
+    vec<std::byte>
+    getGeometryIndices(const Mesh&, const VkIndexType) noexcept;
+
+    vec<GeometryLod>
+    getGeometryLods(const Mesh&) noexcept;
+
+    vec<std::byte>
+    getGeometryMeshlets(const Mesh&) noexcept;
+
+    void
+    setGeometryBounds(GeometryMesh&, const Mesh&) noexcept;
+
+    GeometryData
+    getGeometryData(const Mesh&, const vulkan::VertexFormat) noexcept;
+
+    GeometryData
+    getGeometryData(const MeshFile&, const u64) noexcept(ND_ASSERT_NOTHROW);
+
+    VkDeviceSize
+    getGeometryDataSize(const GeometryData&) noexcept;
+
+    bool
+    isGeometryResident(const Geometry&, const u64) noexcept;
+
+    void
+    freeGeometryMesh(Geometry&, const GeometryMesh&) noexcept;
+
+    GeometryMesh
+    setGeometryData(Geometry&,
+                    vulkan::StagingRing&,
+                    const GeometryData&,
+                    const VkDevice,
+                    const VkPhysicalDevice) noexcept(ND_VK_ASSERT_NOTHROW&& ND_ASSERT_NOTHROW);
+
+    void
+    setGeometryMesh(Geometry&, const u64, const GeometryMesh&) noexcept;
+
+    void
+    resetGeometry(Geometry&, const u16, const VkDevice) noexcept(ND_ASSERT_NOTHROW);
+} // namespace nd::src::graphics
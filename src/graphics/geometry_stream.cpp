@@ -0,0 +1,329 @@
+#include "geometry_stream.hpp"
+#include "tools_runtime.hpp"
+
+namespace nd::src::graphics
+{
+    using namespace nd::src::tools;
+
+    using nd::src::graphics::vulkan::getStagingRing;
+    using nd::src::graphics::vulkan::getStagingFree;
+    using nd::src::graphics::vulkan::setStagingCopies;
+    using nd::src::graphics::vulkan::resetStagingRing;
+    using nd::src::graphics::vulkan::allocateCommandBuffers;
+    using nd::src::graphics::vulkan::createFences;
+
+    using nd::src::graphics::vulkan::Objects;
+    using nd::src::graphics::vulkan::SubmitInfoCfg;
+    using nd::src::graphics::vulkan::VertexFormat;
+    using nd::src::graphics::vulkan::MemoryBudget;
+    using nd::src::graphics::vulkan::MemoryStats;
+    using nd::src::graphics::vulkan::getMemoryStats;
+    using nd::src::graphics::vulkan::isMemoryBudgetAvailable;
+
+    void
+    setGeometryStreamPrepared(GeometryStreamQueue& queue, const VertexFormat format) noexcept
+    {
+        auto lock = std::unique_lock {queue.mutex};
+
+        const auto request = std::move(queue.requests.front());
+
+        queue.requests.pop_front();
+
+        lock.unlock();
+
+        auto data = request.file ? getGeometryData(*request.file, request.entry) : getGeometryData(request.mesh, format);
+
+        data.mesh.version = request.version;
+
+        lock.lock();
+
+        queue.prepared.emplace_back(request.index, std::move(data));
+    }
+
+    void
+    setGeometryStreamBarrier(const VkCommandBuffer commandBuffer) noexcept
+    {
+        const auto barrier = VkMemoryBarrier {.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+                                              .pNext         = {},
+                                              .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+                                              .dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT};
+
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, {}, 1, &barrier, 0, nullptr, 0, nullptr);
+    }
+
+    void
+    setGeometryStreamQueued(GeometryStream& stream, GeometryStreamRequest&& request) noexcept
+    {
+        {
+            const auto lock = std::lock_guard {stream.queue->mutex};
+
+            stream.queue->requested[request.index] = request.version;
+            stream.queue->requests.push_back(std::move(request));
+
+            ++stream.queue->undispatched;
+        }
+    }
+
+    bool
+    isGeometryStreamQueued(GeometryStream& stream, const u64 index, const u64 version) noexcept
+    {
+        const auto lock = std::lock_guard {stream.queue->mutex};
+
+        const auto requested = stream.queue->requested.find(index);
+
+        return requested != stream.queue->requested.end() && requested->second == version;
+    }
+
+    GeometryStream
+    getGeometryStream(Objects& objects, const VertexFormat format, const u16 batchCount) noexcept(ND_VK_ASSERT_NOTHROW&& ND_ASSERT_NOTHROW)
+    {
+        ND_SET_SCOPE();
+
+        const auto commandBuffers = allocateCommandBuffers({.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY, .count = batchCount},
+                                                           objects.commandPool.stream.front(),
+                                                           objects.device.handle);
+
+        const auto fences = createFences(objects, {}, batchCount);
+
+        const auto batches = getMapped<GeometryStreamBatch>(batchCount,
+                                                            [&commandBuffers, &fences](const auto index)
+                                                            {
+                                                                return GeometryStreamBatch {.commandBuffer = commandBuffers[index],
+                                                                                            .fence         = fences[index],
+                                                                                            .meshes        = {},
+                                                                                            .recorded      = false,
+                                                                                            .pending       = false};
+                                                            });
+
+        auto stream = GeometryStream {.ring       = getStagingRing(objects.buffer.stream, batchCount),
+                                      .format     = format,
+                                      .batches    = batches,
+                                      .batchIndex = 0,
+                                      .carried    = {},
+                                      .queue      = std::make_unique<GeometryStreamQueue>()};
+
+        stream.queue->undispatched = 0;
+
+        stream.queue->prepare = [queue = stream.queue.get(), format](const u64 first, const u64 last)
+        {
+            for(auto index = first; index < last; ++index)
+            {
+                setGeometryStreamPrepared(*queue, format);
+            }
+        };
+
+        return stream;
+    }
+
+    void
+    setGeometryStreamRequest(GeometryStream& stream, const u64 index, const Mesh& mesh) noexcept
+    {
+        ND_SET_SCOPE();
+
+        if(isGeometryStreamQueued(stream, index, mesh.version))
+        {
+            return;
+        }
+
+        setGeometryStreamQueued(stream, {.index = index, .version = mesh.version, .file = nullptr, .entry = 0, .mesh = mesh});
+    }
+
+    void
+    setGeometryStreamRequest(GeometryStream& stream, const u64 index, const MeshFile& file, const u64 entry) noexcept(ND_ASSERT_NOTHROW)
+    {
+        ND_SET_SCOPE();
+
+        ND_ASSERT(file.format == stream.format && entry < file.entries.size());
+
+        const auto version = entry + 1;
+
+        if(isGeometryStreamQueued(stream, index, version))
+        {
+            return;
+        }
+
+        setGeometryStreamQueued(stream, {.index = index, .version = version, .file = &file, .entry = entry, .mesh = {}});
+    }
+
+    void
+    setGeometryStreamJobs(GeometryStream& stream, JobSystem& jobs) noexcept(ND_ASSERT_NOTHROW)
+    {
+        ND_SET_SCOPE();
+
+        auto count = u64 {0};
+
+        {
+            const auto lock = std::lock_guard {stream.queue->mutex};
+
+            count = std::exchange(stream.queue->undispatched, 0);
+        }
+
+        if(count)
+        {
+            setJobs(jobs, stream.queue->counter, count, 1, stream.queue->prepare);
+        }
+    }
+
+    bool
+    isGeometryStreamBudgeted(const Geometry& geometry, const MemoryStats& stats, const MemoryBudget& budget, const VkDeviceSize size) noexcept
+    {
+        if(size <= stats.sizeFree)
+        {
+            return true;
+        }
+
+        const auto sizeGrown = std::max(static_cast<VkDeviceSize>(stats.size * geometry.buffer.growth), stats.size + size - stats.sizeFree);
+
+        return isMemoryBudgetAvailable(budget, geometry.buffer.buffer->memory.heapIndex, sizeGrown);
+    }
+
+    bool
+    setGeometryStreamBatch(GeometryStream&        stream,
+                           Geometry&              geometry,
+                           const MemoryBudget&    budget,
+                           const VkDevice         device,
+                           const VkPhysicalDevice physicalDevice) noexcept(ND_VK_ASSERT_NOTHROW&& ND_ASSERT_NOTHROW)
+    {
+        ND_SET_SCOPE();
+
+        for(u16 offset = 0; offset < stream.batches.size(); ++offset)
+        {
+            const auto batchIndex = static_cast<u16>((stream.batchIndex + offset) % stream.batches.size());
+
+            auto& batch = stream.batches[batchIndex];
+
+            if(!batch.pending)
+            {
+                continue;
+            }
+
+            if(vkGetFenceStatus(device, batch.fence) != VK_SUCCESS)
+            {
+                break;
+            }
+
+            const auto lock = std::lock_guard {stream.queue->mutex};
+
+            for(const auto& [index, mesh]: batch.meshes)
+            {
+                const auto requested = stream.queue->requested.find(index);
+
+                if(requested == stream.queue->requested.end() || requested->second != mesh.version)
+                {
+                    freeGeometryMesh(geometry, mesh);
+
+                    continue;
+                }
+
+                setGeometryMesh(geometry, index, mesh);
+
+                stream.queue->requested.erase(requested);
+            }
+
+            resetStagingRing(stream.ring, batchIndex);
+
+            batch.meshes.clear();
+            batch.pending = false;
+        }
+
+        auto& batch = stream.batches[stream.batchIndex];
+
+        if(batch.pending)
+        {
+            return false;
+        }
+
+        auto prepared = vec<std::pair<u64, GeometryData>> {};
+
+        {
+            const auto lock = std::lock_guard {stream.queue->mutex};
+
+            auto free = getStagingFree(stream.ring);
+
+            const auto stats = getMemoryStats(geometry.buffer.allocator);
+
+            auto placed = VkDeviceSize {0};
+
+            while(stream.ring.uploads.empty() && !stream.queue->prepared.empty())
+            {
+                const auto& data = stream.queue->prepared.front().second;
+
+                const auto size = getGeometryDataSize(data) + 6 * stream.ring.alignment;
+                const auto fits = size <= free || (prepared.empty() && free == stream.ring.buffer.size);
+
+                if(!fits || !isGeometryStreamBudgeted(geometry, stats, budget, placed + getGeometryDataSize(data)))
+                {
+                    break;
+                }
+
+                free -= std::min(size, free);
+                placed += getGeometryDataSize(data);
+
+                prepared.push_back(std::move(stream.queue->prepared.front()));
+
+                stream.queue->prepared.pop_front();
+            }
+        }
+
+        if(prepared.empty() && (stream.ring.uploads.empty() || !getStagingFree(stream.ring)))
+        {
+            return false;
+        }
+
+        for(const auto& [index, data]: prepared)
+        {
+            stream.carried.emplace_back(index, setGeometryData(geometry, stream.ring, data, device, physicalDevice));
+        }
+
+        const auto commandBufferBeginInfo = VkCommandBufferBeginInfo {.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+                                                                      .flags = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT};
+
+        ND_VK_ASSERT(vkResetCommandBuffer(batch.commandBuffer, {}));
+        ND_VK_ASSERT(vkBeginCommandBuffer(batch.commandBuffer, &commandBufferBeginInfo));
+
+        setGeometryStreamBarrier(batch.commandBuffer);
+        setStagingCopies(stream.ring, batch.commandBuffer, stream.batchIndex);
+        setGeometryStreamBarrier(batch.commandBuffer);
+
+        if(stream.ring.uploads.empty())
+        {
+            batch.meshes = std::move(stream.carried);
+
+            stream.carried.clear();
+        }
+
+        ND_VK_ASSERT(vkEndCommandBuffer(batch.commandBuffer));
+        ND_VK_ASSERT(vkResetFences(device, 1, &batch.fence));
+
+        batch.recorded = true;
+
+        return true;
+    }
+
+    void
+    setGeometryStreamSubmit(GeometryStream& stream, const VkQueue queue) noexcept(ND_VK_ASSERT_NOTHROW)
+    {
+        ND_SET_SCOPE();
+
+        auto& batch = stream.batches[stream.batchIndex];
+
+        if(!batch.recorded)
+        {
+            return;
+        }
+
+        const auto submitInfoCfg = SubmitInfoCfg {.stages           = {},
+                                                  .semaphoresWait   = {},
+                                                  .semaphoresSignal = {},
+                                                  .commandBuffers   = array {batch.commandBuffer}};
+
+        const auto submitInfos = array {getSubmitInfo(submitInfoCfg)};
+
+        ND_VK_ASSERT(vkQueueSubmit(queue, submitInfos.size(), submitInfos.data(), batch.fence));
+
+        batch.recorded = false;
+        batch.pending  = true;
+
+        stream.batchIndex = static_cast<u16>((stream.batchIndex + 1) % stream.batches.size());
+    }
+} // namespace nd::src::graphics
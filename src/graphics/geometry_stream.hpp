@@ -0,0 +1,89 @@
+#pragma once
+
+#include "pch.hpp"
+#include "tools.hpp"
+#include "job.hpp"
+
+// nd::src::graphics::vulkan
+
+#include "objects_complete.hpp"
+
+// nd::src::graphics
+
+#include "geometry.hpp"
+#include "mesh_file.hpp"
+
+namespace nd::src::graphics
+{
+    struct GeometryStreamRequest final
+    {
+        u64 index;
+        u64 version;
+
+        const MeshFile* file;
+        u64             entry;
+
+        Mesh mesh;
+    };
+
+    struct GeometryStreamBatch final
+    {
+        vulkan::CommandBuffer commandBuffer;
+        vulkan::Fence         fence;
+
+        vec<std::pair<u64, GeometryMesh>> meshes;
+
+        bool recorded;
+        bool pending;
+    };
+
+    struct GeometryStreamQueue final
+    {
+        std::mutex mutex;
+
+        std::deque<GeometryStreamRequest>        requests;
+        std::deque<std::pair<u64, GeometryData>> prepared;
+
+        map<u64, u64> requested;
+
+        u64 undispatched;
+
+        tools::JobCounter  counter;
+        tools::JobFunction prepare;
+    };
+
+    struct GeometryStream final
+    {
+        vulkan::StagingRing  ring;
+        vulkan::VertexFormat format;
+
+        vec<GeometryStreamBatch> batches;
+        u16                      batchIndex;
+
+        vec<std::pair<u64, GeometryMesh>> carried;
+
+        unique<GeometryStreamQueue> queue;
+    };
+
+    GeometryStream
+    getGeometryStream(vulkan::Objects&, const vulkan::VertexFormat, const u16) noexcept(ND_VK_ASSERT_NOTHROW&& ND_ASSERT_NOTHROW);
+
+    void
+    setGeometryStreamRequest(GeometryStream&, const u64, const Mesh&) noexcept;
+
+    void
+    setGeometryStreamRequest(GeometryStream&, const u64, const MeshFile&, const u64) noexcept(ND_ASSERT_NOTHROW);
+
+    void
+    setGeometryStreamJobs(GeometryStream&, tools::JobSystem&) noexcept(ND_ASSERT_NOTHROW);
+
+    bool
+    setGeometryStreamBatch(GeometryStream&,
+                           Geometry&,
+                           const vulkan::MemoryBudget&,
+                           const VkDevice,
+                           const VkPhysicalDevice) noexcept(ND_VK_ASSERT_NOTHROW&& ND_ASSERT_NOTHROW);
+
+    void
+    setGeometryStreamSubmit(GeometryStream&, const VkQueue) noexcept(ND_VK_ASSERT_NOTHROW);
+} // namespace nd::src::graphics
@@ -0,0 +1,134 @@
+#include "mesh_cluster.hpp"
+#include "tools_runtime.hpp"
+
+namespace nd::src::graphics
+{
+    using namespace nd::src::tools;
+
+    Meshlet
+    getMeshletBounds(const span<const Index> indices, const span<const Vertex> vertices, const u32 firstIndex, const u32 indexCount) noexcept
+    {
+        ND_SET_SCOPE();
+
+        const auto triangles = indices.subspan(firstIndex, indexCount);
+
+        auto min = vertices[triangles.front()].position;
+        auto max = vertices[triangles.front()].position;
+
+        for(const auto index: triangles)
+        {
+            min = glm::min(min, vertices[index].position);
+            max = glm::max(max, vertices[index].position);
+        }
+
+        auto meshlet = Meshlet {.firstIndex = firstIndex,
+                                .indexCount = indexCount,
+                                .center     = (max + min) * 0.5f,
+                                .radius     = 0.0f,
+                                .coneAxis   = glm::vec3(0.0f),
+                                .coneCutoff = 1.0f};
+
+        for(const auto index: triangles)
+        {
+            meshlet.radius = std::max(meshlet.radius, glm::length(vertices[index].position - meshlet.center));
+        }
+
+        auto normals = vec<glm::vec3> {};
+
+        normals.reserve(triangles.size() / 3);
+
+        for(u64 triangle = 0; triangle + 2 < triangles.size(); triangle += 3)
+        {
+            const auto first  = vertices[triangles[triangle + 0]].position;
+            const auto second = vertices[triangles[triangle + 1]].position;
+            const auto third  = vertices[triangles[triangle + 2]].position;
+
+            const auto normal = glm::cross(second - first, third - first);
+            const auto length = glm::length(normal);
+
+            if(length > std::numeric_limits<f32>::epsilon())
+            {
+                normals.push_back(normal / length);
+                meshlet.coneAxis += normals.back();
+            }
+        }
+
+        const auto axisLength = glm::length(meshlet.coneAxis);
+
+        if(axisLength <= std::numeric_limits<f32>::epsilon())
+        {
+            return meshlet;
+        }
+
+        meshlet.coneAxis /= axisLength;
+
+        auto dotMin = 1.0f;
+
+        for(const auto& normal: normals)
+        {
+            dotMin = std::min(dotMin, glm::dot(normal, meshlet.coneAxis));
+        }
+
+        if(dotMin <= 0.1f)
+        {
+            return meshlet;
+        }
+
+        meshlet.coneCutoff = std::sqrt(1.0f - dotMin * dotMin);
+
+        return meshlet;
+    }
+
+    vec<Meshlet>
+    getMeshlets(const Mesh& mesh, const u16 vertexMax, const u16 triangleMax) noexcept
+    {
+        ND_SET_SCOPE();
+
+        auto meshlets = vec<Meshlet> {};
+
+        auto marks = vec<u32>(mesh.vertices.size(), 0);
+
+        auto firstIndex  = u32 {0};
+        auto vertexCount = u16 {0};
+
+        for(u32 index = 0; index + 2 < mesh.indices.size(); index += 3)
+        {
+            const auto triangle = span {mesh.indices}.subspan(index, 3);
+
+            const auto getVertexNew = [&marks, &triangle](const u32 mark)
+            {
+                return static_cast<u16>(std::count_if(triangle.begin(),
+                                                      triangle.end(),
+                                                      [&marks, mark](const auto vertex)
+                                                      {
+                                                          return marks[vertex] != mark;
+                                                      }));
+            };
+
+            if(index > firstIndex && (vertexCount + getVertexNew(meshlets.size() + 1) > vertexMax || (index - firstIndex) / 3 >= triangleMax))
+            {
+                meshlets.push_back(getMeshletBounds(mesh.indices, mesh.vertices, firstIndex, index - firstIndex));
+
+                firstIndex  = index;
+                vertexCount = 0;
+            }
+
+            const auto mark = static_cast<u32>(meshlets.size() + 1);
+
+            for(const auto vertex: triangle)
+            {
+                vertexCount += marks[vertex] != mark;
+                marks[vertex] = mark;
+            }
+        }
+
+        const auto indexCount = static_cast<u32>(mesh.indices.size() / 3 * 3);
+
+        if(indexCount > firstIndex)
+        {
+            meshlets.push_back(getMeshletBounds(mesh.indices, mesh.vertices, firstIndex, indexCount - firstIndex));
+        }
+
+        return meshlets;
+    }
+} // namespace nd::src::graphics
@@ -0,0 +1,17 @@
+#pragma once
+
+#include "pch.hpp"
+#include "tools.hpp"
+
+// nd::src::graphics
+
+#include "scene.hpp"
+
+namespace nd::src::graphics
+{
+    Meshlet
+    getMeshletBounds(const span<const Index>, const span<const Vertex>, const u32, const u32) noexcept;
+
+    vec<Meshlet>
+    getMeshlets(const Mesh&, const u16, const u16) noexcept;
+} // namespace nd::src::graphics
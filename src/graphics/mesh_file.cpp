@@ -0,0 +1,360 @@
+#include "mesh_file.hpp"
+#include "geometry.hpp"
+#include "tools_runtime.hpp"
+
+#if !defined(_WIN32)
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
+namespace nd::src::graphics
+{
+    using namespace nd::src::tools;
+
+    using nd::src::graphics::vulkan::VertexFormat;
+
+    const auto meshFileMagic   = array {'N', 'D', 'M', 'F'};
+    const auto meshFileVersion = 3U;
+
+    const auto meshFileTableAlignment = 64ULL;
+    const auto meshFileDataAlignment  = 4096ULL;
+    const auto meshFileBlobAlignment  = 16ULL;
+
+    u64
+    getMeshFileOffsetAligned(const u64 offset, const u64 alignment) noexcept
+    {
+        return (offset + alignment - 1) / alignment * alignment;
+    }
+
+    // compared so that no value read from disk can wrap around
+    bool
+    isMeshFileRange(const MeshFile& file, const u64 offset, const u64 size) noexcept
+    {
+        return offset <= file.size && size <= file.size - offset;
+    }
+
+    template<typename Type>
+    bool
+    isMeshFileIndicesValid(const span<const std::byte> indices, const u32 vertexCount) noexcept
+    {
+        for(u64 offset = 0; offset < indices.size(); offset += sizeof(Type))
+        {
+            auto index = Type {};
+
+            std::memcpy(&index, indices.data() + offset, sizeof(Type));
+
+            if(index >= vertexCount)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool
+    isMeshFileMeshletsValid(const span<const std::byte> meshlets, const MeshFileLod& lod) noexcept
+    {
+        for(u64 offset = 0; offset < meshlets.size(); offset += sizeof(GeometryMeshlet))
+        {
+            auto meshlet = GeometryMeshlet {};
+
+            std::memcpy(&meshlet, meshlets.data() + offset, sizeof(GeometryMeshlet));
+
+            if(u64 {meshlet.firstIndex} + meshlet.indexCount > lod.indexCount || meshlet.indexCount % 3)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    bool
+    isMeshFileEntryValid(const MeshFile& file, const MeshFileEntry& entry) noexcept
+    {
+        if(entry.indexType != VK_INDEX_TYPE_UINT16 && entry.indexType != VK_INDEX_TYPE_UINT32)
+        {
+            return false;
+        }
+
+        if(!isMeshFileRange(file, entry.vertexOffset, entry.vertexSize) || !isMeshFileRange(file, entry.indexOffset, entry.indexSize) ||
+           !isMeshFileRange(file, entry.meshletOffset, entry.meshletSize))
+        {
+            return false;
+        }
+
+        if(entry.vertexSize != entry.vertexCount * getGeometryVertexSize(file.format) ||
+           entry.indexSize != entry.indexCount * getGeometryIndexSize(static_cast<VkIndexType>(entry.indexType)) ||
+           entry.meshletSize != entry.meshletCount * sizeof(GeometryMeshlet))
+        {
+            return false;
+        }
+
+        if(entry.lodCount < 1 || entry.lodCount > MeshFileEntry::lodCountMax)
+        {
+            return false;
+        }
+
+        const auto lodsValid = std::all_of(entry.lods.begin(),
+                                           entry.lods.begin() + entry.lodCount,
+                                           [&entry](const auto& lod)
+                                           {
+                                               return u64 {lod.firstIndex} + lod.indexCount <= entry.indexCount;
+                                           });
+
+        if(!lodsValid || !isMeshFileMeshletsValid(getMeshFileMeshlets(file, entry), entry.lods.front()))
+        {
+            return false;
+        }
+
+        const auto indices = getMeshFileIndices(file, entry);
+
+        return entry.indexType == VK_INDEX_TYPE_UINT16 ? isMeshFileIndicesValid<u16>(indices, entry.vertexCount)
+                                                       : isMeshFileIndicesValid<u32>(indices, entry.vertexCount);
+    }
+
+    bool
+    isMeshFileHeaderValid(const MeshFile& file) noexcept
+    {
+        if(file.size < sizeof(MeshFileHeader))
+        {
+            return false;
+        }
+
+        const auto& header = *reinterpret_cast<const MeshFileHeader*>(file.data);
+
+        if(header.magic != meshFileMagic || header.version != meshFileVersion || header.size != file.size)
+        {
+            return false;
+        }
+
+        if(header.vertexFormat > static_cast<u32>(VertexFormat::quantized))
+        {
+            return false;
+        }
+
+        return header.tableOffset % alignof(MeshFileEntry) == 0 && header.meshCount <= file.size / sizeof(MeshFileEntry) &&
+               isMeshFileRange(file, header.tableOffset, header.meshCount * sizeof(MeshFileEntry));
+    }
+
+    MeshFile
+    getMeshFileValidated(MeshFile&& file, const VertexFormat format) noexcept
+    {
+        if(!isMeshFileHeaderValid(file) || reinterpret_cast<const MeshFileHeader*>(file.data)->vertexFormat != static_cast<u32>(format))
+        {
+            destroyMeshFile(file);
+
+            return {};
+        }
+
+        const auto& header = *reinterpret_cast<const MeshFileHeader*>(file.data);
+
+        file.format  = format;
+        file.entries = {reinterpret_cast<const MeshFileEntry*>(file.data + header.tableOffset), header.meshCount};
+
+        for(const auto& entry: file.entries)
+        {
+            if(!isMeshFileEntryValid(file, entry))
+            {
+                destroyMeshFile(file);
+
+                return {};
+            }
+        }
+
+        return std::move(file);
+    }
+
+    MeshFile
+    createMeshFile(const str& path, const VertexFormat format) noexcept
+    {
+        ND_SET_SCOPE();
+
+#if !defined(_WIN32)
+        const auto descriptor = open(path.c_str(), O_RDONLY);
+
+        if(descriptor < 0)
+        {
+            return {};
+        }
+
+        struct stat status = {};
+
+        if(fstat(descriptor, &status) != 0)
+        {
+            close(descriptor);
+
+            return {};
+        }
+
+        const auto size = static_cast<u64>(status.st_size);
+        const auto data = size ? mmap(nullptr, size, PROT_READ, MAP_PRIVATE, descriptor, 0) : MAP_FAILED;
+
+        close(descriptor);
+
+        if(data == MAP_FAILED)
+        {
+            return {};
+        }
+
+        madvise(data, size, MADV_SEQUENTIAL);
+        madvise(data, size, MADV_WILLNEED);
+
+        return getMeshFileValidated(
+            {.data = static_cast<const std::byte*>(data), .size = size, .format = format, .entries = {}, .buffer = {}},
+            format);
+#else
+        auto stream = std::ifstream(path, std::ios::binary | std::ios::ate);
+
+        if(!stream.is_open())
+        {
+            return {};
+        }
+
+        auto buffer = vec<std::byte>(static_cast<u64>(stream.tellg()));
+
+        stream.seekg(0);
+        stream.read(reinterpret_cast<char*>(buffer.data()), buffer.size());
+
+        const auto data = buffer.data();
+        const auto size = buffer.size();
+
+        return getMeshFileValidated({.data = data, .size = size, .format = format, .entries = {}, .buffer = std::move(buffer)}, format);
+#endif
+    }
+
+    void
+    destroyMeshFile(MeshFile& file) noexcept
+    {
+        ND_SET_SCOPE();
+
+#if !defined(_WIN32)
+        if(file.data)
+        {
+            munmap(const_cast<std::byte*>(file.data), file.size);
+        }
+#endif
+
+        file = {};
+    }
+
+    span<const std::byte>
+    getMeshFileVertices(const MeshFile& file, const MeshFileEntry& entry) noexcept
+    {
+        ND_SET_SCOPE();
+
+        return {file.data + entry.vertexOffset, entry.vertexSize};
+    }
+
+    span<const std::byte>
+    getMeshFileIndices(const MeshFile& file, const MeshFileEntry& entry) noexcept
+    {
+        ND_SET_SCOPE();
+
+        return {file.data + entry.indexOffset, entry.indexSize};
+    }
+
+    span<const std::byte>
+    getMeshFileMeshlets(const MeshFile& file, const MeshFileEntry& entry) noexcept
+    {
+        ND_SET_SCOPE();
+
+        return {file.data + entry.meshletOffset, entry.meshletSize};
+    }
+
+    void
+    setMeshFile(const str& path, const span<const Mesh> meshes, const VertexFormat format) noexcept(ND_ASSERT_NOTHROW)
+    {
+        ND_SET_SCOPE();
+
+        auto entries  = vec<MeshFileEntry>(meshes.size());
+        auto vertices = vec<vec<std::byte>>(meshes.size());
+        auto indices  = vec<vec<std::byte>>(meshes.size());
+        auto meshlets = vec<vec<std::byte>>(meshes.size());
+
+        const auto tableOffset = getMeshFileOffsetAligned(sizeof(MeshFileHeader), meshFileTableAlignment);
+
+        auto offset = getMeshFileOffsetAligned(tableOffset + entries.size() * sizeof(MeshFileEntry), meshFileDataAlignment);
+
+        for(u64 index = 0; index < meshes.size(); ++index)
+        {
+            auto geometryMesh = GeometryMesh {};
+
+            const auto indexType = getGeometryIndexType(meshes[index]);
+            const auto lods      = getGeometryLods(meshes[index]);
+
+            ND_ASSERT(lods.size() <= MeshFileEntry::lodCountMax);
+
+            setGeometryBounds(geometryMesh, meshes[index]);
+
+            vertices[index] = getGeometryVertices(meshes[index], format, geometryMesh);
+            indices[index]  = getGeometryIndices(meshes[index], indexType);
+            meshlets[index] = getGeometryMeshlets(meshes[index]);
+
+            auto& entry = entries[index];
+
+            const auto indexOffset = getMeshFileOffsetAligned(offset + vertices[index].size(), meshFileBlobAlignment);
+
+            entry = {.vertexOffset  = offset,
+                     .vertexSize    = vertices[index].size(),
+                     .indexOffset   = indexOffset,
+                     .indexSize     = indices[index].size(),
+                     .meshletOffset = getMeshFileOffsetAligned(indexOffset + indices[index].size(), meshFileBlobAlignment),
+                     .meshletSize   = meshlets[index].size(),
+                     .vertexCount   = static_cast<u32>(meshes[index].vertices.size()),
+                     .indexCount    = lods.back().firstIndex + lods.back().indexCount,
+                     .indexType     = static_cast<u32>(indexType),
+                     .lodCount      = static_cast<u32>(lods.size()),
+                     .meshletCount  = static_cast<u32>(meshes[index].meshlets.size()),
+                     .reserved      = 0,
+                     .scale         = geometryMesh.scale,
+                     .bias          = geometryMesh.bias,
+                     .center        = geometryMesh.center,
+                     .radius        = geometryMesh.radius,
+                     .lods          = {}};
+
+            for(u64 lod = 0; lod < lods.size(); ++lod)
+            {
+                entry.lods[lod] = {.firstIndex = lods[lod].firstIndex, .indexCount = lods[lod].indexCount, .error = lods[lod].error, .reserved = 0};
+            }
+
+            offset = getMeshFileOffsetAligned(entry.meshletOffset + entry.meshletSize, meshFileBlobAlignment);
+        }
+
+        const auto header = MeshFileHeader {.magic        = meshFileMagic,
+                                            .version      = meshFileVersion,
+                                            .vertexFormat = static_cast<u32>(format),
+                                            .meshCount    = static_cast<u32>(meshes.size()),
+                                            .tableOffset  = tableOffset,
+                                            .size         = offset};
+
+        auto stream = std::ofstream(path, std::ios::binary | std::ios::trunc);
+
+        ND_ASSERT(stream.is_open());
+
+        const auto write = [&stream](const u64 position, const void* data, const u64 size)
+        {
+            const auto padding = vec<char>(position - static_cast<u64>(stream.tellp()), 0);
+
+            stream.write(padding.data(), padding.size());
+            stream.write(static_cast<const char*>(data), size);
+        };
+
+        write(0, &header, sizeof(header));
+        write(tableOffset, entries.data(), entries.size() * sizeof(MeshFileEntry));
+
+        for(u64 index = 0; index < meshes.size(); ++index)
+        {
+            write(entries[index].vertexOffset, vertices[index].data(), vertices[index].size());
+            write(entries[index].indexOffset, indices[index].data(), indices[index].size());
+            write(entries[index].meshletOffset, meshlets[index].data(), meshlets[index].size());
+        }
+
+        write(offset, nullptr, 0);
+
+        ND_ASSERT(stream.good());
+    }
+} // namespace nd::src::graphics
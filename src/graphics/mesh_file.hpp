@@ -0,0 +1,94 @@
+#pragma once
+
+#include "pch.hpp"
+#include "tools.hpp"
+
+// nd::src::graphics::vulkan
+
+#include "objects_complete.hpp"
+
+// nd::src::graphics
+
+#include "scene.hpp"
+
+namespace nd::src::graphics
+{
+    struct MeshFileHeader final
+    {
+        array<char, 4> magic;
+
+        u32 version;
+        u32 vertexFormat;
+        u32 meshCount;
+
+        u64 tableOffset;
+        u64 size;
+    };
+
+    struct MeshFileLod final
+    {
+        u32 firstIndex;
+        u32 indexCount;
+
+        f32 error;
+
+        u32 reserved;
+    };
+
+    struct MeshFileEntry final
+    {
+        static constexpr u8 lodCountMax = 8;
+
+        u64 vertexOffset;
+        u64 vertexSize;
+        u64 indexOffset;
+        u64 indexSize;
+        u64 meshletOffset;
+        u64 meshletSize;
+
+        u32 vertexCount;
+        u32 indexCount;
+        u32 indexType;
+        u32 lodCount;
+        u32 meshletCount;
+        u32 reserved;
+
+        glm::vec3 scale;
+        glm::vec3 bias;
+        glm::vec3 center;
+
+        f32 radius;
+
+        array<MeshFileLod, lodCountMax> lods;
+    };
+
+    struct MeshFile final
+    {
+        const std::byte* data;
+        u64              size;
+
+        vulkan::VertexFormat format;
+
+        span<const MeshFileEntry> entries;
+
+        vec<std::byte> buffer;
+    };
+
+    MeshFile
+    createMeshFile(const str&, const vulkan::VertexFormat) noexcept;
+
+    void
+    destroyMeshFile(MeshFile&) noexcept;
+
+    span<const std::byte>
+    getMeshFileVertices(const MeshFile&, const MeshFileEntry&) noexcept;
+
+    span<const std::byte>
+    getMeshFileIndices(const MeshFile&, const MeshFileEntry&) noexcept;
+
+    span<const std::byte>
+    getMeshFileMeshlets(const MeshFile&, const MeshFileEntry&) noexcept;
+
+    void
+    setMeshFile(const str&, const span<const Mesh>, const vulkan::VertexFormat) noexcept(ND_ASSERT_NOTHROW);
+} // namespace nd::src::graphics
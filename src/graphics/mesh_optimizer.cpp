@@ -0,0 +1,259 @@
+#include "mesh_optimizer.hpp"
+#include "tools_runtime.hpp"
+
+namespace nd::src::graphics
+{
+    using namespace nd::src::tools;
+
+    struct MeshAdjacency final
+    {
+        vec<u32> offsets;
+        vec<u32> triangles;
+    };
+
+    MeshAdjacency
+    getMeshAdjacency(const span<const Index> indices, const u64 vertexCount) noexcept
+    {
+        auto adjacency = MeshAdjacency {.offsets = vec<u32>(vertexCount + 1, 0U), .triangles = vec<u32>(indices.size())};
+
+        for(const auto index: indices)
+        {
+            ++adjacency.offsets[index + 1];
+        }
+
+        for(u64 index = 1; index < adjacency.offsets.size(); ++index)
+        {
+            adjacency.offsets[index] += adjacency.offsets[index - 1];
+        }
+
+        auto heads = vec<u32>(adjacency.offsets.begin(), adjacency.offsets.end() - 1);
+
+        for(u64 index = 0; index < indices.size(); ++index)
+        {
+            adjacency.triangles[heads[indices[index]]++] = static_cast<u32>(index / 3);
+        }
+
+        return adjacency;
+    }
+
+    i64
+    getMeshDeadEnd(vec<Index>& deadEnds, const vec<u32>& liveCounts, u64& cursor) noexcept
+    {
+        while(!deadEnds.empty())
+        {
+            const auto vertex = deadEnds.back();
+
+            deadEnds.pop_back();
+
+            if(liveCounts[vertex])
+            {
+                return vertex;
+            }
+        }
+
+        for(; cursor < liveCounts.size(); ++cursor)
+        {
+            if(liveCounts[cursor])
+            {
+                return static_cast<i64>(cursor);
+            }
+        }
+
+        return -1;
+    }
+
+    MeshCacheStats
+    getMeshCacheStats(const Mesh& mesh, const u16 cacheSize) noexcept
+    {
+        ND_SET_SCOPE();
+
+        if(mesh.indices.empty() || mesh.vertices.empty())
+        {
+            return {.acmr = 0.0f, .atvr = 0.0f};
+        }
+
+        auto timestamps = vec<u64>(mesh.vertices.size(), 0ULL);
+        auto misses     = u64 {0};
+
+        for(const auto index: mesh.indices)
+        {
+            if(!timestamps[index] || misses - timestamps[index] >= cacheSize)
+            {
+                timestamps[index] = ++misses;
+            }
+        }
+
+        return {.acmr = static_cast<f32>(misses) / (mesh.indices.size() / 3), .atvr = static_cast<f32>(misses) / mesh.vertices.size()};
+    }
+
+    Mesh
+    getMeshWelded(const Mesh& mesh) noexcept
+    {
+        ND_SET_SCOPE();
+
+        auto welded = Mesh {.indices = vec<Index>(mesh.indices.size()), .vertices = {}, .lods = {}, .meshlets = {}, .version = mesh.version};
+        auto remap  = vec<Index>(mesh.vertices.size());
+        auto unique = std::unordered_map<str_v, Index> {};
+
+        unique.reserve(mesh.vertices.size());
+
+        for(u64 index = 0; index < mesh.vertices.size(); ++index)
+        {
+            const auto key = str_v {reinterpret_cast<const char*>(&mesh.vertices[index]), sizeof(Vertex)};
+
+            const auto [entry, inserted] = unique.try_emplace(key, static_cast<Index>(welded.vertices.size()));
+
+            if(inserted)
+            {
+                welded.vertices.push_back(mesh.vertices[index]);
+            }
+
+            remap[index] = entry->second;
+        }
+
+        for(u64 index = 0; index < mesh.indices.size(); ++index)
+        {
+            welded.indices[index] = remap[mesh.indices[index]];
+        }
+
+        return welded;
+    }
+
+    vec<Index>
+    getIndicesCacheOptimized(const span<const Index> indices, const u64 vertexCount, const u16 cacheSize) noexcept
+    {
+        ND_SET_SCOPE();
+
+        const auto adjacency = getMeshAdjacency(indices, vertexCount);
+
+        auto optimized = vec<Index> {};
+
+        auto liveCounts = vec<u32>(vertexCount);
+        auto timestamps = vec<u64>(vertexCount, 0ULL);
+        auto emitted    = vec<bool>(indices.size() / 3, false);
+
+        auto deadEnds   = vec<Index> {};
+        auto candidates = vec<Index> {};
+
+        for(u64 index = 0; index < vertexCount; ++index)
+        {
+            liveCounts[index] = adjacency.offsets[index + 1] - adjacency.offsets[index];
+        }
+
+        optimized.reserve(indices.size());
+
+        auto time   = u64 {cacheSize} + 1;
+        auto cursor = u64 {0};
+        auto fan    = getMeshDeadEnd(deadEnds, liveCounts, cursor);
+
+        while(fan >= 0)
+        {
+            candidates.clear();
+
+            for(auto triangle = adjacency.offsets[fan]; triangle < adjacency.offsets[fan + 1]; ++triangle)
+            {
+                const auto triangleIndex = adjacency.triangles[triangle];
+
+                if(emitted[triangleIndex])
+                {
+                    continue;
+                }
+
+                for(u64 corner = 0; corner < 3; ++corner)
+                {
+                    const auto vertex = indices[triangleIndex * 3 + corner];
+
+                    optimized.push_back(vertex);
+                    deadEnds.push_back(vertex);
+                    candidates.push_back(vertex);
+
+                    --liveCounts[vertex];
+
+                    if(time - timestamps[vertex] > cacheSize)
+                    {
+                        timestamps[vertex] = time++;
+                    }
+                }
+
+                emitted[triangleIndex] = true;
+            }
+
+            auto priorityMax = i64 {-1};
+
+            fan = -1;
+
+            for(const auto vertex: candidates)
+            {
+                if(!liveCounts[vertex])
+                {
+                    continue;
+                }
+
+                const auto age      = time - timestamps[vertex];
+                const auto priority = age + 2 * liveCounts[vertex] <= cacheSize ? static_cast<i64>(age) : 0;
+
+                if(priority > priorityMax)
+                {
+                    priorityMax = priority;
+                    fan         = vertex;
+                }
+            }
+
+            if(fan < 0)
+            {
+                fan = getMeshDeadEnd(deadEnds, liveCounts, cursor);
+            }
+        }
+
+        return optimized;
+    }
+
+    Mesh
+    getMeshCacheOptimized(const Mesh& mesh, const u16 cacheSize) noexcept
+    {
+        ND_SET_SCOPE();
+
+        return {.indices  = getIndicesCacheOptimized(mesh.indices, mesh.vertices.size(), cacheSize),
+                .vertices = mesh.vertices,
+                .lods     = {},
+                .meshlets = {},
+                .version  = mesh.version};
+    }
+
+    Mesh
+    getMeshFetchOptimized(const Mesh& mesh) noexcept
+    {
+        ND_SET_SCOPE();
+
+        const auto unused = std::numeric_limits<Index>::max();
+
+        auto optimized = Mesh {.indices = vec<Index>(mesh.indices.size()), .vertices = {}, .lods = {}, .meshlets = {}, .version = mesh.version};
+        auto remap     = vec<Index>(mesh.vertices.size(), unused);
+
+        optimized.vertices.reserve(mesh.vertices.size());
+
+        for(u64 index = 0; index < mesh.indices.size(); ++index)
+        {
+            auto& vertex = remap[mesh.indices[index]];
+
+            if(vertex == unused)
+            {
+                vertex = static_cast<Index>(optimized.vertices.size());
+
+                optimized.vertices.push_back(mesh.vertices[mesh.indices[index]]);
+            }
+
+            optimized.indices[index] = vertex;
+        }
+
+        return optimized;
+    }
+
+    Mesh
+    getMeshOptimized(const Mesh& mesh, const u16 cacheSize) noexcept
+    {
+        ND_SET_SCOPE();
+
+        return getMeshFetchOptimized(getMeshCacheOptimized(getMeshWelded(mesh), cacheSize));
+    }
+} // namespace nd::src::graphics
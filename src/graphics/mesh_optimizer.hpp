@@ -0,0 +1,35 @@
+#pragma once
+
+#include "pch.hpp"
+#include "tools.hpp"
+
+// nd::src::graphics
+
+#include "scene.hpp"
+
+namespace nd::src::graphics
+{
+    struct MeshCacheStats final
+    {
+        f32 acmr; // cache misses per triangle
+        f32 atvr; // cache misses per vertex
+    };
+
+    MeshCacheStats
+    getMeshCacheStats(const Mesh&, const u16) noexcept;
+
+    Mesh
+    getMeshWelded(const Mesh&) noexcept;
+
+    vec<Index>
+    getIndicesCacheOptimized(const span<const Index>, const u64, const u16) noexcept;
+
+    Mesh
+    getMeshCacheOptimized(const Mesh&, const u16) noexcept;
+
+    Mesh
+    getMeshFetchOptimized(const Mesh&) noexcept;
+
+    Mesh
+    getMeshOptimized(const Mesh&, const u16) noexcept;
+} // namespace nd::src::graphics
@@ -0,0 +1,319 @@
+#include "mesh_simplifier.hpp"
+#include "mesh_optimizer.hpp"
+#include "tools_runtime.hpp"
+
+namespace nd::src::graphics
+{
+    using namespace nd::src::tools;
+
+    // symmetric 4x4 matrix stored as its upper triangle
+    using Quadric = array<f64, 10>;
+
+    struct MeshCollapse final
+    {
+        f64 cost;
+
+        Index source;
+        Index target;
+
+        u32 sourceVersion;
+        u32 targetVersion;
+    };
+
+    u64
+    getMeshEdgeKey(const Index first, const Index second) noexcept
+    {
+        return static_cast<u64>(std::min(first, second)) << 32 | std::max(first, second);
+    }
+
+    glm::vec3
+    getTriangleNormal(const glm::vec3 first, const glm::vec3 second, const glm::vec3 third) noexcept
+    {
+        return glm::cross(second - first, third - first);
+    }
+
+    void
+    setQuadricPlane(Quadric& quadric, const glm::vec3 normal, const glm::vec3 point, const f64 weight) noexcept
+    {
+        const auto plane = array<f64, 4> {normal.x, normal.y, normal.z, -glm::dot(normal, point)};
+
+        for(u64 row = 0, index = 0; row < plane.size(); ++row)
+        {
+            for(u64 column = row; column < plane.size(); ++column, ++index)
+            {
+                quadric[index] += plane[row] * plane[column] * weight;
+            }
+        }
+    }
+
+    Quadric
+    getQuadricSum(const Quadric& first, const Quadric& second) noexcept
+    {
+        auto quadric = Quadric {};
+
+        for(u64 index = 0; index < quadric.size(); ++index)
+        {
+            quadric[index] = first[index] + second[index];
+        }
+
+        return quadric;
+    }
+
+    f64
+    getQuadricError(const Quadric& quadric, const glm::vec3 position) noexcept
+    {
+        const auto point = array<f64, 4> {position.x, position.y, position.z, 1.0};
+
+        auto error = 0.0;
+
+        for(u64 row = 0, index = 0; row < point.size(); ++row)
+        {
+            for(u64 column = row; column < point.size(); ++column, ++index)
+            {
+                error += quadric[index] * point[row] * point[column] * (row == column ? 1.0 : 2.0);
+            }
+        }
+
+        return std::max(error, 0.0);
+    }
+
+    bool
+    isMeshCollapseValid(const vec<Index>&        triangles,
+                        const vec<bool>&         alive,
+                        const vec<u32>&          sourceTriangles,
+                        const span<const Vertex> vertices,
+                        const Index              source,
+                        const Index              target) noexcept
+    {
+        for(const auto triangle: sourceTriangles)
+        {
+            const auto corners = &triangles[triangle * 3];
+
+            if(!alive[triangle] || corners[0] == target || corners[1] == target || corners[2] == target)
+            {
+                continue;
+            }
+
+            const auto before = getTriangleNormal(vertices[corners[0]].position, vertices[corners[1]].position, vertices[corners[2]].position);
+            const auto after  = getTriangleNormal(vertices[corners[0] == source ? target : corners[0]].position,
+                                                 vertices[corners[1] == source ? target : corners[1]].position,
+                                                 vertices[corners[2] == source ? target : corners[2]].position);
+
+            if(glm::dot(before, after) <= 0.0f && glm::dot(before, before) > 0.0f)
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    MeshLod
+    getMeshSimplified(const span<const Index> indices, const span<const Vertex> vertices, const u64 indexTarget) noexcept
+    {
+        ND_SET_SCOPE();
+
+        const auto boundaryWeight = 10.0;
+
+        const auto compare = [](const MeshCollapse& first, const MeshCollapse& second)
+        {
+            return first.cost > second.cost;
+        };
+
+        auto triangles       = vec<Index>(indices.begin(), indices.end());
+        auto alive           = vec<bool>(triangles.size() / 3, true);
+        auto quadrics        = vec<Quadric>(vertices.size(), Quadric {});
+        auto versions        = vec<u32>(vertices.size(), 0U);
+        auto removed         = vec<bool>(vertices.size(), false);
+        auto locked          = vec<bool>(vertices.size(), false);
+        auto vertexTriangles = vec<vec<u32>>(vertices.size());
+        auto edges           = std::unordered_map<u64, u32> {};
+        auto positions       = std::unordered_map<str_v, Index> {};
+        auto collapses       = std::priority_queue<MeshCollapse, vec<MeshCollapse>, decltype(compare)>(compare);
+
+        for(u64 index = 0; index < vertices.size(); ++index)
+        {
+            const auto key = str_v {reinterpret_cast<const char*>(&vertices[index].position), sizeof(glm::vec3)};
+
+            if(const auto [iterator, inserted] = positions.emplace(key, static_cast<Index>(index)); !inserted)
+            {
+                locked[index]            = true;
+                locked[iterator->second] = true;
+            }
+        }
+
+        for(u64 triangle = 0; triangle < alive.size(); ++triangle)
+        {
+            const auto corners = &triangles[triangle * 3];
+
+            const auto normal = getTriangleNormal(vertices[corners[0]].position, vertices[corners[1]].position, vertices[corners[2]].position);
+            const auto length = glm::length(normal);
+
+            for(u64 corner = 0; corner < 3; ++corner)
+            {
+                vertexTriangles[corners[corner]].push_back(static_cast<u32>(triangle));
+
+                ++edges[getMeshEdgeKey(corners[corner], corners[(corner + 1) % 3])];
+
+                if(length > 0.0f)
+                {
+                    setQuadricPlane(quadrics[corners[corner]], normal / length, vertices[corners[0]].position, 1.0);
+                }
+            }
+        }
+
+        for(u64 triangle = 0; triangle < alive.size(); ++triangle)
+        {
+            const auto corners = &triangles[triangle * 3];
+
+            const auto normal = getTriangleNormal(vertices[corners[0]].position, vertices[corners[1]].position, vertices[corners[2]].position);
+
+            for(u64 corner = 0; corner < 3; ++corner)
+            {
+                const auto first  = corners[corner];
+                const auto second = corners[(corner + 1) % 3];
+
+                const auto perpendicular = glm::cross(vertices[second].position - vertices[first].position, normal);
+                const auto length        = glm::length(perpendicular);
+
+                if(edges[getMeshEdgeKey(first, second)] != 1 || length <= 0.0f)
+                {
+                    continue;
+                }
+
+                setQuadricPlane(quadrics[first], perpendicular / length, vertices[first].position, boundaryWeight);
+                setQuadricPlane(quadrics[second], perpendicular / length, vertices[first].position, boundaryWeight);
+            }
+        }
+
+        const auto setCollapses = [&](const Index first, const Index second)
+        {
+            const auto quadric = getQuadricSum(quadrics[first], quadrics[second]);
+
+            for(const auto [source, target]: {array {first, second}, array {second, first}})
+            {
+                if(!locked[source])
+                {
+                    collapses.push({.cost          = getQuadricError(quadric, vertices[target].position),
+                                    .source        = source,
+                                    .target        = target,
+                                    .sourceVersion = versions[source],
+                                    .targetVersion = versions[target]});
+                }
+            }
+        };
+
+        for(const auto& [key, count]: edges)
+        {
+            setCollapses(static_cast<Index>(key >> 32), static_cast<Index>(key & std::numeric_limits<u32>::max()));
+        }
+
+        auto triangleCount = alive.size();
+        auto error         = 0.0;
+
+        while(triangleCount * 3 > indexTarget && !collapses.empty())
+        {
+            const auto collapse = collapses.top();
+
+            collapses.pop();
+
+            const auto source = collapse.source;
+            const auto target = collapse.target;
+
+            if(removed[source] || removed[target] || versions[source] != collapse.sourceVersion || versions[target] != collapse.targetVersion)
+            {
+                continue;
+            }
+
+            if(!isMeshCollapseValid(triangles, alive, vertexTriangles[source], vertices, source, target))
+            {
+                continue;
+            }
+
+            for(const auto triangle: vertexTriangles[source])
+            {
+                const auto corners = &triangles[triangle * 3];
+
+                if(!alive[triangle])
+                {
+                    continue;
+                }
+
+                if(corners[0] == target || corners[1] == target || corners[2] == target)
+                {
+                    alive[triangle] = false;
+
+                    --triangleCount;
+
+                    continue;
+                }
+
+                std::replace(corners, corners + 3, source, target);
+
+                vertexTriangles[target].push_back(triangle);
+            }
+
+            quadrics[target] = getQuadricSum(quadrics[source], quadrics[target]);
+            removed[source]  = true;
+            error            = std::max(error, std::sqrt(collapse.cost));
+
+            ++versions[target];
+
+            vertexTriangles[source].clear();
+
+            for(const auto triangle: vertexTriangles[target])
+            {
+                const auto corners = &triangles[triangle * 3];
+
+                for(u64 corner = 0; alive[triangle] && corner < 3; ++corner)
+                {
+                    if(corners[corner] != target)
+                    {
+                        setCollapses(target, corners[corner]);
+                    }
+                }
+            }
+        }
+
+        auto lod = MeshLod {.indices = {}, .error = static_cast<f32>(error)};
+
+        lod.indices.reserve(triangleCount * 3);
+
+        for(u64 triangle = 0; triangle < alive.size(); ++triangle)
+        {
+            if(alive[triangle])
+            {
+                lod.indices.insert(lod.indices.end(), &triangles[triangle * 3], &triangles[triangle * 3] + 3);
+            }
+        }
+
+        return lod;
+    }
+
+    vec<MeshLod>
+    getMeshLods(const Mesh& mesh, const u16 levelCount, const f32 ratio, const u16 cacheSize) noexcept
+    {
+        ND_SET_SCOPE();
+
+        auto lods = vec<MeshLod> {};
+
+        auto indexCount = mesh.indices.size();
+
+        for(u16 level = 0; level < levelCount; ++level)
+        {
+            auto lod = getMeshSimplified(mesh.indices, mesh.vertices, static_cast<u64>(indexCount * ratio) / 3 * 3);
+
+            if(lod.indices.empty() || lod.indices.size() * 10 > indexCount * 9)
+            {
+                break;
+            }
+
+            indexCount  = lod.indices.size();
+            lod.indices = getIndicesCacheOptimized(lod.indices, mesh.vertices.size(), cacheSize);
+
+            lods.push_back(std::move(lod));
+        }
+
+        return lods;
+    }
+} // namespace nd::src::graphics
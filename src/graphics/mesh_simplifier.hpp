@@ -0,0 +1,17 @@
+#pragma once
+
+#include "pch.hpp"
+#include "tools.hpp"
+
+// nd::src::graphics
+
+#include "scene.hpp"
+
+namespace nd::src::graphics
+{
+    MeshLod
+    getMeshSimplified(const span<const Index>, const span<const Vertex>, const u64) noexcept;
+
+    vec<MeshLod>
+    getMeshLods(const Mesh&, const u16, const f32, const u16) noexcept;
+} // namespace nd::src::graphics
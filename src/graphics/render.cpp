@@ -10,30 +10,130 @@ namespace nd::src::graphics
     using nd::src::graphics::vulkan::resetCommandPools;
     using nd::src::graphics::vulkan::allocateDescriptorSets;
     using nd::src::graphics::vulkan::allocateCommandBuffers;
+    using nd::src::graphics::vulkan::getTransientSlice;
+    using nd::src::graphics::vulkan::getTransientSpace;
+    using nd::src::graphics::vulkan::setTransientData;
+    using nd::src::graphics::vulkan::resetTransientAllocator;
+    using nd::src::graphics::vulkan::setDefragmentBinding;
+    using nd::src::graphics::vulkan::setDefragmentBindings;
+    using nd::src::graphics::vulkan::getDefragmentMoves;
+    using nd::src::graphics::vulkan::setDefragmentCopies;
+    using nd::src::graphics::vulkan::resetDefragmenter;
+    using nd::src::graphics::vulkan::getHostAllocationSnapshot;
+    using nd::src::graphics::vulkan::getHostAllocationDelta;
+    using nd::src::graphics::vulkan::isGrowablePending;
+    using nd::src::graphics::vulkan::setGrowableCopies;
+    using nd::src::graphics::vulkan::getMemoryBudget;
+    using nd::src::graphics::vulkan::setTimelineWait;
+    using nd::src::graphics::vulkan::getTimelineSubmitInfo;
 
     using nd::src::graphics::vulkan::Objects;
+    using nd::src::graphics::vulkan::Buffer;
+    using nd::src::graphics::vulkan::TransientSlice;
     using nd::src::graphics::vulkan::SubmitInfoCfg;
     using nd::src::graphics::vulkan::PresentInfoCfg;
 
-    struct Memory final
+    struct Uniform final
     {
-        VkDeviceSize offset;
-        VkDeviceSize size;
+        glm::mat4 transform;
     };
 
-    struct MemoryLayout final
+    // matches the push constant block of meshlet.glsl, 128 bytes
+    struct MeshletConstants final
     {
-        Memory vertex;
-        Memory index;
-        Memory uniform;
-        Memory stage;
+        array<glm::vec4, 6> planes;
+        glm::vec3           eye;
+
+        u32 firstMeshlet;
+        u32 meshletCount;
+        u32 firstIndex;
+        u32 indexShort;
+        u32 command;
     };
 
-    struct Uniform final
+    struct View final
     {
-        glm::mat4 transform;
+        glm::mat4 viewProjection;
+
+        Camera camera;
+    };
+
+    constexpr auto lodErrorMax = 1.0f;
+
+    constexpr auto meshletCommandCountMax = 1024U;
+
+    constexpr auto drawLodCountMax = 8U;
+
+    constexpr auto drawCountSize = VkDeviceSize {4 * sizeof(u32)};
+
+    // matches the push constant block of draw.glsl, 128 bytes
+    struct DrawConstants final
+    {
+        array<glm::vec4, 6> planes;
+        glm::vec3           eye;
+
+        f32 projection;
+        f32 errorMax;
+        f32 near;
+        f32 far;
+        f32 reserved;
     };
 
+    struct DrawRegion final
+    {
+        VkDeviceSize commandOffset;
+        VkDeviceSize commandSize;
+        VkDeviceSize modelOffset;
+        VkDeviceSize modelSize;
+
+        u32 instanceMax;
+    };
+
+    // matches Lod, Mesh and Instance of draw.glsl, std430
+    struct DrawLod final
+    {
+        u32 firstIndex;
+        u32 indexCount;
+        f32 error;
+        u32 reserved;
+    };
+
+    struct DrawMesh final
+    {
+        i32 vertexOffset;
+        u32 lodCount;
+        u32 indexShort;
+        u32 reserved;
+
+        array<DrawLod, drawLodCountMax> lods;
+    };
+
+    struct DrawInstance final
+    {
+        glm::mat4 model;
+        glm::vec4 sphere;
+
+        u32 meshIndex;
+        u32 skip;
+        f32 scale;
+        u32 reserved;
+    };
+
+    View
+    getView(const Camera& camera) noexcept
+    {
+        ND_SET_SCOPE();
+
+        // the camera's field of view is horizontal, the projection takes the vertical one
+        const auto fovy = 2.0f * std::atan(std::tan(glm::radians(camera.fovx) * 0.5f) / camera.ratio);
+
+        const auto viewMatrix       = glm::lookAt(camera.location, camera.center, camera.up);
+        const auto projectionMatrix = glm::perspective(fovy, camera.ratio, camera.near, camera.far);
+        const auto vulkanMatrix     = glm::mat4(1.0f, 0.0f, 0.0f, 0.0f, 0.0f, -1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f);
+
+        return View {.viewProjection = vulkanMatrix * projectionMatrix * viewMatrix, .camera = camera};
+    }
+
     Scene
     getScene(const Objects& objects, const f64 dt) noexcept
     {
@@ -55,155 +155,510 @@ namespace nd::src::graphics
                                      {.position = {+0.5f, +0.5f, -0.5f}, .color = {0.75f, 0.75f, 0.75f}},
                                      {.position = {+0.5f, -0.5f, -0.5f}, .color = {0.75f, 0.75f, 0.75f}},
                                      {.position = {-0.5f, -0.5f, -0.5f}, .color = {0.75f, 0.75f, 0.75f}},
-                                     {.position = {-0.5f, +0.5f, -0.5f}, .color = {0.75f, 0.75f, 0.75f}}}}},
+                                     {.position = {-0.5f, +0.5f, -0.5f}, .color = {0.75f, 0.75f, 0.75f}}},
+                           .version  = 1}},
             .instances = {
                 {.transform = {.rotation = {0.0f, 0.0f, 0.0f}, .scalation = {1.0f, 1.0f, 1.0f}, .translation = {0.0f, 0.0f, 0.0f}}, .meshIndex = 0}}};
     }
 
-    MemoryLayout
-    getMemoryLayout(const Objects& objects, const f64 dt) noexcept
+    glm::mat4
+    getInstanceMatrix(const Instance& instance, const GeometryMesh& mesh) noexcept
     {
-        ND_SET_SCOPE();
+        return getTransformMatrix(instance.transform) * getGeometryTransform(mesh);
+    }
 
-        return MemoryLayout {.vertex  = {.offset = 0 * 1024, .size = 5 * 1024},
-                             .index   = {.offset = 5 * 1024, .size = 1 * 1024},
-                             .uniform = {.offset = 6 * 1024, .size = 2 * 1024},
-                             .stage   = {.offset = 0 * 1024, .size = 8 * 1024}};
+    f32
+    getInstanceScale(const Instance& instance) noexcept
+    {
+        const auto& scalation = instance.transform.scalation;
+
+        return std::max({std::abs(scalation.x), std::abs(scalation.y), std::abs(scalation.z)});
     }
 
-    void
-    setTransfer(const Objects&              objects,
-                const Scene&                scene,
-                const MemoryLayout&         memoryLayout,
-                const RenderContext&        renderContext,
-                const RenderContext::Frame& renderContextFrame,
-                const u16                   frameCount,
-                const u16                   frameIndex,
-                const u16                   index,
-                const f64                   dt) noexcept(ND_VK_ASSERT_NOTHROW)
+    glm::vec4
+    getInstanceSphere(const FrustumSpheres& spheres, const u64 instanceIndex) noexcept
     {
-        ND_SET_SCOPE();
+        return {spheres.x[instanceIndex], spheres.y[instanceIndex], spheres.z[instanceIndex], spheres.radius[instanceIndex]};
+    }
 
-        static auto loaded = false;
+    std::pair<u64, u64>
+    getRecordRange(const u64 count, const u16 shareCount, const u16 share) noexcept
+    {
+        const auto size      = count / shareCount;
+        const auto remainder = count % shareCount;
 
-        const auto width  = static_cast<u32>(objects.swapchain.width);
-        const auto height = static_cast<u32>(objects.swapchain.height);
+        const auto first = size * share + std::min<u64>(share, remainder);
 
-        const auto identityMatrix   = glm::mat4(1.0f);
-        const auto modelMatrix      = glm::rotate(identityMatrix, static_cast<f32>(dt * glm::radians(90.0f)), glm::vec3(0.0f, 0.0f, 1.0f));
-        const auto viewMatrix       = glm::lookAt(glm::vec3(1.0f, 1.0f, 1.0f), glm::vec3(0.0f, 0.0f, 0.0f), glm::vec3(0.0f, 0.0f, 1.0f));
-        const auto projectionMatrix = glm::perspective(glm::radians(60.0f), static_cast<f32>(width) / height, 0.1f, 10.0f);
-        const auto vulkanMatrix     = glm::mat4(1.0f, 0.0f, 0.0f, 0.0f, 0.0f, -1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f);
+        return {first, first + size + (share < remainder ? 1 : 0)};
+    }
 
-        const auto uniform = Uniform {.transform = vulkanMatrix * projectionMatrix * viewMatrix * modelMatrix};
+    VkDeviceSize
+    getFrameSize(const Buffer& buffer, const u16 frameCount) noexcept
+    {
+        return buffer.size / frameCount / 256 * 256;
+    }
 
-        static const auto indices  = vec<Index> {0, 1, 2};
-        static const auto vertices = vec<Vertex> {{.position = {+0.0, -0.5, 0.0}, .color = {1.0, 0.0, 0.0}},
-                                                  {.position = {+0.5, +0.5, 0.0}, .color = {0.0, 1.0, 0.0}},
-                                                  {.position = {-0.5, +0.5, 0.0}, .color = {0.0, 0.0, 1.0}}};
+    DrawRegion
+    getDrawRegion(const Objects& objects, const u16 frameCount, const u16 frameIndex) noexcept
+    {
+        const auto frameSize   = getFrameSize(objects.buffer.draw, frameCount);
+        const auto frameOffset = frameSize * frameIndex;
 
-        static const auto uniforms = vec<Uniform>(frameCount, uniform);
+        const auto instanceMax = (frameSize - 2 * 256) / (2 * sizeof(VkDrawIndexedIndirectCommand) + sizeof(glm::mat4));
+        const auto commandSize = (drawCountSize + 2 * instanceMax * sizeof(VkDrawIndexedIndirectCommand) + 255) / 256 * 256;
 
-        const auto commandBufferBeginInfo = VkCommandBufferBeginInfo {.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+        return {.commandOffset = frameOffset,
+                .commandSize   = commandSize,
+                .modelOffset   = frameOffset + commandSize,
+                .modelSize     = instanceMax * sizeof(glm::mat4),
+                .instanceMax   = static_cast<u32>(instanceMax)};
+    }
 
-        ND_VK_ASSERT(vkBeginCommandBuffer(renderContextFrame.commandBuffer.transfer[0], &commandBufferBeginInfo));
+    u64
+    getDrawInstanceMax(const RenderContext& renderContext, const DrawRegion& drawRegion) noexcept
+    {
+        const auto& transient = renderContext.transient;
 
-        if(!loaded)
+        const auto space    = getTransientSpace(transient);
+        const auto reserved = renderContext.geometry.meshes.size() * sizeof(DrawMesh) + sizeof(Uniform) +
+                              meshletCommandCountMax * sizeof(glm::mat4) + 4 * transient.alignment;
+
+        return std::min<u64>(drawRegion.instanceMax, space > reserved ? (space - reserved) / sizeof(DrawInstance) : 0);
+    }
+
+    DrawMesh
+    getDrawMesh(const GeometryMesh& mesh) noexcept
+    {
+        auto drawMesh = DrawMesh {.vertexOffset = mesh.vertexOffset,
+                                  .lodCount     = static_cast<u32>(std::min<u64>(mesh.lods.size(), drawLodCountMax)),
+                                  .indexShort   = mesh.indexType == VK_INDEX_TYPE_UINT16,
+                                  .reserved     = 0,
+                                  .lods         = {}};
+
+        for(u32 lod = 0; lod < drawMesh.lodCount; ++lod)
         {
-            const auto verticesSize = sizeof(Vertex) * vertices.size();
-            const auto indicesSize  = sizeof(Index) * indices.size();
-            const auto uniformsSize = sizeof(Uniform) * uniforms.size();
+            drawMesh.lods[lod] = {.firstIndex = mesh.lods[lod].firstIndex,
+                                  .indexCount = mesh.lods[lod].indexCount,
+                                  .error      = mesh.lods[lod].error,
+                                  .reserved   = 0};
+        }
 
-            const auto verticesOffset = 0ULL;
-            const auto indicesOffset  = verticesOffset + verticesSize;
-            const auto uniformsOffset = indicesOffset + indicesSize;
+        return drawMesh;
+    }
 
-            void* data;
+    DrawInstance
+    getDrawInstance(const Geometry&       geometry,
+                    const Instance&       instance,
+                    const FrustumSpheres& spheres,
+                    const u64             instanceIndex,
+                    const bool            skip) noexcept
+    {
+        auto drawInstance = DrawInstance {.model     = glm::mat4(0.0f),
+                                          .sphere    = glm::vec4(0.0f),
+                                          .meshIndex = static_cast<u32>(instance.meshIndex),
+                                          .skip      = skip || !isGeometryResident(geometry, instance.meshIndex),
+                                          .scale     = getInstanceScale(instance),
+                                          .reserved  = 0};
+
+        if(!drawInstance.skip)
+        {
+            const auto& mesh = geometry.meshes[instance.meshIndex];
 
-            vkMapMemory(objects.device.handle,
-                        objects.device.memory.host.handle,
-                        objects.buffer.stage.offset,
-                        verticesSize + indicesSize + uniformsSize,
-                        {},
-                        &data);
+            drawInstance.model  = getInstanceMatrix(instance, mesh);
+            drawInstance.sphere = getInstanceSphere(spheres, instanceIndex);
+        }
 
-            memcpy((i8*)data + verticesOffset, vertices.data(), verticesSize);
-            memcpy((i8*)data + indicesOffset, indices.data(), indicesSize);
-            memcpy((i8*)data + uniformsOffset, uniforms.data(), uniformsSize);
+        return drawInstance;
+    }
+
+    void
+    setDrawBindings(const Objects&              objects,
+                    const RenderContext::Frame& renderContextFrame,
+                    const TransientSlice&       meshSlice,
+                    const TransientSlice&       instanceSlice,
+                    const DrawRegion&           drawRegion) noexcept
+    {
+        const auto& draw = objects.buffer.draw.handle;
+
+        const auto bufferInfos =
+            array {VkDescriptorBufferInfo {.buffer = meshSlice.buffer, .offset = meshSlice.offset, .range = meshSlice.size},
+                   VkDescriptorBufferInfo {.buffer = instanceSlice.buffer, .offset = instanceSlice.offset, .range = instanceSlice.size},
+                   VkDescriptorBufferInfo {.buffer = draw, .offset = drawRegion.commandOffset, .range = drawRegion.commandSize},
+                   VkDescriptorBufferInfo {.buffer = draw, .offset = drawRegion.modelOffset, .range = drawRegion.modelSize}};
+
+        const auto writes = getMapped<VkDescriptorBufferInfo, VkWriteDescriptorSet>(
+            bufferInfos,
+            [&renderContextFrame](const auto& bufferInfo, const auto binding)
+            {
+                return VkWriteDescriptorSet {.sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                                             .pNext            = {},
+                                             .dstSet           = renderContextFrame.descriptorSet.draw,
+                                             .dstBinding       = static_cast<u32>(binding),
+                                             .dstArrayElement  = 0,
+                                             .descriptorCount  = 1,
+                                             .descriptorType   = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                                             .pImageInfo       = {},
+                                             .pBufferInfo      = &bufferInfo,
+                                             .pTexelBufferView = {}};
+            });
+
+        vkUpdateDescriptorSets(objects.device.handle, writes.size(), writes.data(), 0, nullptr);
+    }
+
+    void
+    setFixedBindings(const Objects& objects, const RenderContext& renderContext) noexcept
+    {
+        const auto uniformInfo = VkDescriptorBufferInfo {.buffer = objects.buffer.transient.handle, .offset = 0, .range = sizeof(Uniform)};
+        const auto cullInfo    = VkDescriptorBufferInfo {.buffer = objects.buffer.cull.handle, .offset = 0, .range = VK_WHOLE_SIZE};
 
-            vkUnmapMemory(objects.device.handle, objects.device.memory.host.handle);
+        auto writes = vec<VkWriteDescriptorSet> {};
 
-            const auto regions = array {VkBufferCopy {.srcOffset = verticesOffset, .dstOffset = memoryLayout.vertex.offset, .size = verticesSize},
-                                        VkBufferCopy {.srcOffset = indicesOffset, .dstOffset = memoryLayout.index.offset, .size = indicesSize},
-                                        VkBufferCopy {.srcOffset = uniformsOffset, .dstOffset = memoryLayout.uniform.offset, .size = uniformsSize}};
+        for(const auto set: renderContext.descriptorSet.mesh)
+        {
+            writes.push_back({.sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                              .pNext            = {},
+                              .dstSet           = set,
+                              .dstBinding       = 0,
+                              .dstArrayElement  = 0,
+                              .descriptorCount  = 1,
+                              .descriptorType   = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+                              .pImageInfo       = {},
+                              .pBufferInfo      = &uniformInfo,
+                              .pTexelBufferView = {}});
+        }
 
-            vkCmdCopyBuffer(renderContextFrame.commandBuffer.transfer[0],
-                            objects.buffer.stage.handle,
-                            objects.buffer.mesh.handle,
-                            regions.size(),
-                            regions.data());
+        for(const auto set: renderContext.descriptorSet.meshlet)
+        {
+            writes.push_back({.sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                              .pNext            = {},
+                              .dstSet           = set,
+                              .dstBinding       = 2,
+                              .dstArrayElement  = 0,
+                              .descriptorCount  = 1,
+                              .descriptorType   = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                              .pImageInfo       = {},
+                              .pBufferInfo      = &cullInfo,
+                              .pTexelBufferView = {}});
+        }
+
+        vkUpdateDescriptorSets(objects.device.handle, writes.size(), writes.data(), 0, nullptr);
+    }
 
-            for(auto index = 0; index < renderContext.descriptorSet.mesh.size(); ++index)
+    bool
+    setTransfer(Objects&                    objects,
+                const Scene&                scene,
+                RenderContext&              renderContext,
+                const RenderContext::Frame& renderContextFrame,
+                const u16                   frameCount,
+                const u16                   frameIndex,
+                const bool                  streamed) noexcept(ND_VK_ASSERT_NOTHROW)
+    {
+        ND_SET_SCOPE();
+
+        static auto loaded = false;
+
+        const auto& meshFile = renderContext.meshFile;
+
+        const auto commandBufferBeginInfo = VkCommandBufferBeginInfo {.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+
+        for(u64 meshIndex = 0; !meshFile.data && meshIndex < scene.meshes.size(); ++meshIndex)
+        {
+            const auto& mesh = scene.meshes[meshIndex];
+
+            if(!isGeometryResident(renderContext.geometry, meshIndex) || renderContext.geometry.meshes[meshIndex].version != mesh.version)
             {
-                const auto bufferInfo = VkDescriptorBufferInfo {.buffer = objects.buffer.mesh.handle,
-                                                                .offset = sizeof(Uniform) * index + memoryLayout.uniform.offset,
-                                                                .range  = sizeof(Uniform)};
-
-                const auto write = VkWriteDescriptorSet {.sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
-                                                         .pNext            = {},
-                                                         .dstSet           = renderContext.descriptorSet.mesh[index],
-                                                         .dstBinding       = 0,
-                                                         .dstArrayElement  = 0,
-                                                         .descriptorCount  = 1,
-                                                         .descriptorType   = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-                                                         .pImageInfo       = {},
-                                                         .pBufferInfo      = &bufferInfo,
-                                                         .pTexelBufferView = {}};
-
-                const auto writes = array {write};
-
-                vkUpdateDescriptorSets(objects.device.handle, writes.size(), writes.data(), 0, nullptr);
+                setGeometryStreamRequest(renderContext.stream, meshIndex, mesh);
+            }
+        }
+
+        if(!loaded)
+        {
+            for(u64 entry = 0; entry < meshFile.entries.size(); ++entry)
+            {
+                setGeometryStreamRequest(renderContext.stream, entry, meshFile, entry);
+            }
+
+            setFixedBindings(objects, renderContext);
+
+            for(u16 index = 0; index < renderContext.descriptorSet.meshlet.size(); ++index)
+            {
+                for(u32 binding = 0; binding < 2; ++binding)
+                {
+                    setDefragmentBinding(renderContext.defragmenter,
+                                         {.buffer     = &objects.buffer.mesh,
+                                          .set        = renderContext.descriptorSet.meshlet[index],
+                                          .binding    = binding,
+                                          .type       = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                                          .offset     = 0,
+                                          .range      = VK_WHOLE_SIZE,
+                                          .handle     = {},
+                                          .frameIndex = index},
+                                         objects.device.handle);
+                }
             }
 
             loaded = true;
         }
 
+        const auto defragmented = !streamed && renderContext.stream.carried.empty() &&
+                                  getDefragmentMoves(renderContext.defragmenter, objects.device.handle, objects.physicalDevice);
+
+        setDefragmentBindings(renderContext.defragmenter, frameIndex, objects.device.handle);
+
+        if(!isGrowablePending(renderContext.geometry.buffer) && !defragmented)
+        {
+            return false;
+        }
+
+        ND_VK_ASSERT(vkBeginCommandBuffer(renderContextFrame.commandBuffer.transfer[0], &commandBufferBeginInfo));
+
+        setGrowableCopies(renderContext.geometry.buffer, renderContextFrame.commandBuffer.transfer[0]);
+        setDefragmentCopies(renderContext.defragmenter, renderContextFrame.commandBuffer.transfer[0], frameIndex);
+
         ND_VK_ASSERT(vkEndCommandBuffer(renderContextFrame.commandBuffer.transfer[0]));
 
+        const auto signalValues = array {renderContextFrame.timeline.value};
+
+        auto timelineSubmitInfo = getTimelineSubmitInfo({.valuesWait = {}, .valuesSignal = signalValues});
+
         const auto submitInfoTransferCfg = SubmitInfoCfg {.stages           = {},
                                                           .semaphoresWait   = {},
-                                                          .semaphoresSignal = array {renderContextFrame.semaphore.transfer},
-                                                          .commandBuffers   = array {renderContextFrame.commandBuffer.transfer[0]}};
+                                                          .semaphoresSignal = array {renderContext.timeline.transfer},
+                                                          .commandBuffers   = array {renderContextFrame.commandBuffer.transfer[0]},
+                                                          .next             = &timelineSubmitInfo};
 
         const auto submitInfoTransfers = array {getSubmitInfo(submitInfoTransferCfg)};
 
         vkQueueSubmit(renderContext.queue.transfer[0], submitInfoTransfers.size(), submitInfoTransfers.data(), VK_NULL_HANDLE);
+
+        return true;
     }
 
-    void
+    bool
     setCompute(const Objects&              objects,
                const Scene&                scene,
-               const MemoryLayout&         memoryLayout,
-               const RenderContext&        renderContext,
+               RenderContext&              renderContext,
                const RenderContext::Frame& renderContextFrame,
                const u16                   frameCount,
                const u16                   frameIndex,
-               const u16                   index,
-               const f64                   dt) noexcept(ND_VK_ASSERT_NOTHROW)
+               const bool                  transferred,
+               const View&                 view) noexcept(ND_VK_ASSERT_NOTHROW)
     {
         ND_SET_SCOPE();
+
+        const auto commandSize = sizeof(VkDrawIndexedIndirectCommand);
+        const auto frameSize   = getFrameSize(objects.buffer.cull, frameCount);
+        const auto frameOffset = frameSize * frameIndex;
+
+        const auto drawRegion = getDrawRegion(objects, frameCount, frameIndex);
+
+        auto commands  = vec<VkDrawIndexedIndirectCommand> {};
+        auto constants = vec<MeshletConstants> {};
+
+        auto indexHead = static_cast<u32>((frameOffset + meshletCommandCountMax * commandSize) / sizeof(u32));
+
+        const auto indexEnd = static_cast<u32>((frameOffset + frameSize) / sizeof(u32));
+
+        renderContext.meshletCommands.assign(scene.instances.size(), std::nullopt);
+
+        if(scene.instances.empty() || renderContext.geometry.meshes.empty())
+        {
+            return false;
+        }
+
+        const auto planes = getFrustumPlanes(view.viewProjection);
+
+        const auto lodCfg = getGeometryLodCfg(view.camera, static_cast<f32>(objects.swapchain.width), lodErrorMax);
+
+        const auto spheres = getFrustumSpheres(scene.instances, renderContext.geometry);
+        auto visible = getFrustumVisible(spheres, planes);
+
+        if(const auto instanceMax = getDrawInstanceMax(renderContext, drawRegion); visible.size() > instanceMax)
+        {
+            if(const auto log = spdlog::get(logMainName); log)
+            {
+                log->warn("{} visible instances, {} drawn", visible.size(), instanceMax);
+            }
+
+            visible.resize(instanceMax);
+        }
+
+        for(const auto instanceIndex: visible)
+        {
+            const auto& instance = scene.instances[instanceIndex];
+
+            const auto& mesh = renderContext.geometry.meshes[instance.meshIndex];
+
+            if(!mesh.meshletCount || commands.size() == meshletCommandCountMax || indexHead + mesh.lods.front().indexCount > indexEnd)
+            {
+                continue;
+            }
+
+            if(getGeometryLod(mesh, lodCfg, getInstanceSphere(spheres, instanceIndex), getInstanceScale(instance)))
+            {
+                continue;
+            }
+
+            const auto command = frameOffset + commands.size() * commandSize;
+
+            const auto model = getTransformMatrix(instance.transform);
+
+            commands.push_back({.indexCount    = 0,
+                                .instanceCount = 1,
+                                .firstIndex    = indexHead,
+                                .vertexOffset  = mesh.vertexOffset,
+                                .firstInstance = static_cast<u32>(commands.size())});
+
+            constants.push_back({.planes       = getFrustumPlanes(view.viewProjection * model),
+                                 .eye          = glm::vec3(glm::inverse(model) * glm::vec4(view.camera.location, 1.0f)),
+                                 .firstMeshlet = mesh.firstMeshlet,
+                                 .meshletCount = mesh.meshletCount,
+                                 .firstIndex   = mesh.lods.front().firstIndex,
+                                 .indexShort   = mesh.indexType == VK_INDEX_TYPE_UINT16,
+                                 .command      = static_cast<u32>(command / sizeof(u32))});
+
+            renderContext.meshletCommands[instanceIndex] = command;
+
+            indexHead += mesh.lods.front().indexCount;
+        }
+
+        const auto drawMeshes = getMapped<GeometryMesh, DrawMesh>(renderContext.geometry.meshes,
+                                                                  [](const auto& mesh, const auto)
+                                                                  {
+                                                                      return getDrawMesh(mesh);
+                                                                  });
+
+        const auto drawInstances = getMapped<u32, DrawInstance>(visible,
+                                                                [&scene, &renderContext, &spheres](const auto instanceIndex, const auto)
+                                                                {
+                                                                    const auto& geometry = renderContext.geometry;
+                                                                    const auto& instance = scene.instances[instanceIndex];
+
+                                                                    const auto skip = renderContext.meshletCommands[instanceIndex].has_value();
+
+                                                                    return getDrawInstance(geometry, instance, spheres, instanceIndex, skip);
+                                                                });
+
+        const auto meshSlice     = setTransientData(renderContext.transient, std::as_bytes(span {drawMeshes}));
+        const auto instanceSlice = setTransientData(renderContext.transient, std::as_bytes(span {drawInstances}));
+
+        if(!drawInstances.empty())
+        {
+            setDrawBindings(objects, renderContextFrame, meshSlice, instanceSlice, drawRegion);
+        }
+
+        const auto drawConstants = DrawConstants {.planes     = planes,
+                                                  .eye        = lodCfg.eye,
+                                                  .projection = lodCfg.projection,
+                                                  .errorMax   = lodCfg.errorMax,
+                                                  .near       = lodCfg.near,
+                                                  .far        = lodCfg.far,
+                                                  .reserved   = 0.0f};
+
+        const auto commandBufferBeginInfo = VkCommandBufferBeginInfo {.sType = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO};
+
+        const auto memoryBarrier = VkMemoryBarrier {.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+                                                    .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+                                                    .dstAccessMask = VK_ACCESS_SHADER_READ_BIT | VK_ACCESS_SHADER_WRITE_BIT};
+
+        const auto drawDescriptorSets    = array {renderContextFrame.descriptorSet.draw};
+        const auto meshletDescriptorSets = array {renderContextFrame.descriptorSet.meshlet};
+
+        const auto commandBuffer = renderContextFrame.commandBuffer.compute[0];
+
+        ND_VK_ASSERT(vkBeginCommandBuffer(commandBuffer, &commandBufferBeginInfo));
+
+        vkCmdFillBuffer(commandBuffer, objects.buffer.draw.handle, drawRegion.commandOffset, drawCountSize, 0);
+
+        if(!commands.empty())
+        {
+            vkCmdUpdateBuffer(commandBuffer, objects.buffer.cull.handle, frameOffset, commands.size() * commandSize, commands.data());
+        }
+
+        vkCmdPipelineBarrier(commandBuffer,
+                             VK_PIPELINE_STAGE_TRANSFER_BIT,
+                             VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT,
+                             0,
+                             1,
+                             &memoryBarrier,
+                             0,
+                             nullptr,
+                             0,
+                             nullptr);
+
+        if(!drawInstances.empty())
+        {
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, objects.pipeline.draw);
+
+            vkCmdBindDescriptorSets(commandBuffer,
+                                    VK_PIPELINE_BIND_POINT_COMPUTE,
+                                    objects.pipelineLayout.draw,
+                                    0,
+                                    drawDescriptorSets.size(),
+                                    drawDescriptorSets.data(),
+                                    0,
+                                    nullptr);
+
+            vkCmdPushConstants(commandBuffer, objects.pipelineLayout.draw, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(drawConstants), &drawConstants);
+
+            vkCmdDispatch(commandBuffer, static_cast<u32>((drawInstances.size() + 63) / 64), 1, 1);
+        }
+
+        if(!constants.empty())
+        {
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_COMPUTE, objects.pipeline.meshlet);
+
+            vkCmdBindDescriptorSets(commandBuffer,
+                                    VK_PIPELINE_BIND_POINT_COMPUTE,
+                                    objects.pipelineLayout.meshlet,
+                                    0,
+                                    meshletDescriptorSets.size(),
+                                    meshletDescriptorSets.data(),
+                                    0,
+                                    nullptr);
+        }
+
+        for(const auto& constant: constants)
+        {
+            vkCmdPushConstants(commandBuffer, objects.pipelineLayout.meshlet, VK_SHADER_STAGE_COMPUTE_BIT, 0, sizeof(constant), &constant);
+
+            vkCmdDispatch(commandBuffer, constant.meshletCount, 1, 1);
+        }
+
+        ND_VK_ASSERT(vkEndCommandBuffer(commandBuffer));
+
+        const auto waitCount      = transferred ? 1 : 0;
+        const auto waitStages     = array {0U | VK_PIPELINE_STAGE_COMPUTE_SHADER_BIT};
+        const auto waitSemaphores = array {renderContext.timeline.transfer};
+        const auto waitValues     = array {renderContextFrame.timeline.value};
+        const auto signalValues   = array {renderContextFrame.timeline.value};
+
+        auto timelineSubmitInfo = getTimelineSubmitInfo({.valuesWait = span {waitValues}.first(waitCount), .valuesSignal = signalValues});
+
+        const auto submitInfoComputeCfg = SubmitInfoCfg {.stages           = span {waitStages}.first(waitCount),
+                                                         .semaphoresWait   = span {waitSemaphores}.first(waitCount),
+                                                         .semaphoresSignal = array {renderContext.timeline.compute},
+                                                         .commandBuffers   = array {commandBuffer},
+                                                         .next             = &timelineSubmitInfo};
+
+        const auto submitInfoComputes = array {getSubmitInfo(submitInfoComputeCfg)};
+
+        vkQueueSubmit(renderContext.queue.compute[0], submitInfoComputes.size(), submitInfoComputes.data(), VK_NULL_HANDLE);
+
+        return true;
     }
 
     void
     setGraphics(const Objects&              objects,
                 const Scene&                scene,
-                const MemoryLayout&         memoryLayout,
-                const RenderContext&        renderContext,
+                RenderContext&              renderContext,
                 const RenderContext::Frame& renderContextFrame,
                 const u16                   frameCount,
                 const u16                   frameIndex,
-                const u16                   index,
-                const f64                   dt) noexcept(ND_VK_ASSERT_NOTHROW)
+                const u16                   imageIndex,
+                const bool                  transferred,
+                const bool                  computed,
+                const View&                 view) noexcept(ND_VK_ASSERT_NOTHROW)
     {
         ND_SET_SCOPE();
 
@@ -217,80 +672,208 @@ namespace nd::src::graphics
         const auto renderPassBeginInfo = VkRenderPassBeginInfo {
             .sType           = VK_STRUCTURE_TYPE_RENDER_PASS_BEGIN_INFO,
             .renderPass      = objects.renderPass,
-            .framebuffer     = objects.swapchainFramebuffers[frameIndex],
+            .framebuffer     = objects.swapchainFramebuffers[imageIndex],
             .renderArea      = {.offset = {.x = 0, .y = 0}, .extent = {.width = width, .height = height}},
             .clearValueCount = static_cast<u32>(clearValues.size()),
             .pClearValues    = clearValues.data()};
 
-        const auto vertexBuffers       = array {objects.buffer.mesh.handle};
-        const auto vertexBufferOffsets = array {memoryLayout.vertex.offset};
-        const auto indexBuffer         = objects.buffer.mesh.handle;
-        const auto indexOffset         = memoryLayout.index.offset;
+        const auto inheritanceInfo = VkCommandBufferInheritanceInfo {.sType       = VK_STRUCTURE_TYPE_COMMAND_BUFFER_INHERITANCE_INFO,
+                                                                     .renderPass  = objects.renderPass,
+                                                                     .subpass     = 0,
+                                                                     .framebuffer = objects.swapchainFramebuffers[imageIndex]};
+
+        const auto secondaryBeginInfo = VkCommandBufferBeginInfo {
+            .sType            = VK_STRUCTURE_TYPE_COMMAND_BUFFER_BEGIN_INFO,
+            .flags            = VK_COMMAND_BUFFER_USAGE_ONE_TIME_SUBMIT_BIT | VK_COMMAND_BUFFER_USAGE_RENDER_PASS_CONTINUE_BIT,
+            .pInheritanceInfo = &inheritanceInfo};
+
+        auto meshletInstances = vec<u64> {};
+
+        for(u64 instanceIndex = 0; instanceIndex < renderContext.meshletCommands.size(); ++instanceIndex)
+        {
+            if(renderContext.meshletCommands[instanceIndex])
+            {
+                meshletInstances.push_back(instanceIndex);
+            }
+        }
+
+        const auto uniform        = Uniform {.transform = view.viewProjection};
+        const auto uniformSlice   = setTransientData(renderContext.transient, std::as_bytes(span {&uniform, 1}));
+        const auto modelSlice     = getTransientSlice(renderContext.transient, meshletInstances.size() * sizeof(glm::mat4));
+        const auto dynamicOffsets = array {static_cast<u32>(uniformSlice.offset)};
+
+        const auto drawRegion = getDrawRegion(objects, frameCount, frameIndex);
+
+        const auto vertexBuffers       = array {objects.buffer.mesh.handle, objects.buffer.draw.handle};
+        const auto vertexBufferOffsets = array {VkDeviceSize {0}, drawRegion.modelOffset};
 
         const auto descriptorSets = array {renderContextFrame.descriptorSet.mesh};
 
-        ND_VK_ASSERT(vkBeginCommandBuffer(renderContextFrame.commandBuffer.graphics[0], &commandBufferBeginInfo));
+        const auto indexTypes = array {VK_INDEX_TYPE_UINT16, VK_INDEX_TYPE_UINT32};
+
+        const auto commandSize = sizeof(VkDrawIndexedIndirectCommand);
 
-        vkCmdBeginRenderPass(renderContextFrame.commandBuffer.graphics[0], &renderPassBeginInfo, VK_SUBPASS_CONTENTS_INLINE);
+        const auto meshletOffset = getFrameSize(objects.buffer.cull, frameCount) * frameIndex;
 
-        vkCmdBindPipeline(renderContextFrame.commandBuffer.graphics[0], VK_PIPELINE_BIND_POINT_GRAPHICS, objects.pipeline.mesh);
-        vkCmdBindDescriptorSets(renderContextFrame.commandBuffer.graphics[0],
-                                VK_PIPELINE_BIND_POINT_GRAPHICS,
-                                objects.pipelineLayout.mesh,
-                                0,
-                                descriptorSets.size(),
-                                descriptorSets.data(),
-                                0,
-                                nullptr);
+        const auto& secondaryBuffers = renderContextFrame.commandBuffer.secondary;
 
-        vkCmdBindVertexBuffers(renderContextFrame.commandBuffer.graphics[0],
-                               0,
-                               vertexBuffers.size(),
-                               vertexBuffers.data(),
-                               vertexBufferOffsets.data());
+        const auto shareCount = static_cast<u16>(secondaryBuffers.size());
 
-        vkCmdBindIndexBuffer(renderContextFrame.commandBuffer.graphics[0], indexBuffer, indexOffset, VK_INDEX_TYPE_UINT16);
+        for(u64 meshletIndex = 0; meshletIndex < meshletInstances.size(); ++meshletIndex)
+        {
+            const auto& instance = scene.instances[meshletInstances[meshletIndex]];
+
+            const auto model = getInstanceMatrix(instance, renderContext.geometry.meshes[instance.meshIndex]);
+
+            std::memcpy(modelSlice.data + meshletIndex * sizeof(glm::mat4), &model, sizeof(model));
+        }
+
+        auto results = vec<VkResult>(shareCount, VK_SUCCESS);
+
+        const auto recordShare = [&](const u16 share)
+        {
+            const auto commandBuffer = secondaryBuffers[share];
+
+            const auto [first, last] = getRecordRange(meshletInstances.size(), shareCount, share);
+
+            if(const auto result = vkBeginCommandBuffer(commandBuffer, &secondaryBeginInfo); result != VK_SUCCESS)
+            {
+                results[share] = result;
+
+                return;
+            }
+
+            vkCmdBindPipeline(commandBuffer, VK_PIPELINE_BIND_POINT_GRAPHICS, objects.pipeline.mesh);
+
+            vkCmdBindVertexBuffers(commandBuffer, 0, vertexBuffers.size(), vertexBuffers.data(), vertexBufferOffsets.data());
 
-        vkCmdDrawIndexed(renderContextFrame.commandBuffer.graphics[0], 6, 1, 0, 0, 0);
+            vkCmdBindDescriptorSets(commandBuffer,
+                                    VK_PIPELINE_BIND_POINT_GRAPHICS,
+                                    objects.pipelineLayout.mesh,
+                                    0,
+                                    descriptorSets.size(),
+                                    descriptorSets.data(),
+                                    dynamicOffsets.size(),
+                                    dynamicOffsets.data());
+
+            for(u32 indexWidth = share; computed && indexWidth < indexTypes.size(); indexWidth += shareCount)
+            {
+                vkCmdBindIndexBuffer(commandBuffer, objects.buffer.mesh.handle, 0, indexTypes[indexWidth]);
+
+                vkCmdDrawIndexedIndirectCount(commandBuffer,
+                                              objects.buffer.draw.handle,
+                                              drawRegion.commandOffset + drawCountSize + indexWidth * drawRegion.instanceMax * commandSize,
+                                              objects.buffer.draw.handle,
+                                              drawRegion.commandOffset + indexWidth * sizeof(u32),
+                                              drawRegion.instanceMax,
+                                              commandSize);
+            }
+
+            if(first < last)
+            {
+                vkCmdBindVertexBuffers(commandBuffer, 1, 1, &objects.buffer.transient.handle, &modelSlice.offset);
+
+                vkCmdBindIndexBuffer(commandBuffer, objects.buffer.cull.handle, 0, VK_INDEX_TYPE_UINT32);
+
+                vkCmdDrawIndexedIndirect(commandBuffer,
+                                         objects.buffer.cull.handle,
+                                         meshletOffset + first * commandSize,
+                                         static_cast<u32>(last - first),
+                                         commandSize);
+            }
+
+            results[share] = vkEndCommandBuffer(commandBuffer);
+        };
+
+        const auto record = JobFunction {[&recordShare](const u64 first, const u64 last)
+                                         {
+                                             for(auto share = first; share < last; ++share)
+                                             {
+                                                 recordShare(static_cast<u16>(share));
+                                             }
+                                         }};
+
+        auto recorded = JobCounter {};
+
+        setJobs(renderContext.jobs, recorded, shareCount, 1, record);
+        setJobsWait(renderContext.jobs, recorded);
+
+        for(const auto result: results)
+        {
+            ND_VK_ASSERT(result);
+        }
+
+        ND_VK_ASSERT(vkBeginCommandBuffer(renderContextFrame.commandBuffer.graphics[0], &commandBufferBeginInfo));
+
+        vkCmdBeginRenderPass(renderContextFrame.commandBuffer.graphics[0], &renderPassBeginInfo, VK_SUBPASS_CONTENTS_SECONDARY_COMMAND_BUFFERS);
+
+        vkCmdExecuteCommands(renderContextFrame.commandBuffer.graphics[0], static_cast<u32>(secondaryBuffers.size()), secondaryBuffers.data());
 
         vkCmdEndRenderPass(renderContextFrame.commandBuffer.graphics[0]);
 
         ND_VK_ASSERT(vkEndCommandBuffer(renderContextFrame.commandBuffer.graphics[0]));
 
-        const auto submitInfoCfg = SubmitInfoCfg {
-            .stages           = array {0U | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT, 0U | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT},
-            .semaphoresWait   = array {renderContext.semaphore.acquired[index], renderContextFrame.semaphore.transfer},
-            .semaphoresSignal = array {renderContextFrame.semaphore.graphics},
-            .commandBuffers   = array {renderContextFrame.commandBuffer.graphics[0]}};
+        const auto waitCount  = transferred || computed ? 2 : 1;
+        const auto waitStages = array {0U | VK_PIPELINE_STAGE_COLOR_ATTACHMENT_OUTPUT_BIT,
+                                       computed ? 0U | VK_PIPELINE_STAGE_DRAW_INDIRECT_BIT | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT
+                                                : 0U | VK_PIPELINE_STAGE_VERTEX_INPUT_BIT};
+        const auto waitSemaphores =
+            array {renderContextFrame.semaphore.acquired, computed ? renderContext.timeline.compute : renderContext.timeline.transfer};
+
+        const auto signalSemaphores = array {renderContext.timeline.graphics, renderContext.semaphore.rendered[imageIndex]};
+
+        const auto waitValues   = array {u64 {0}, renderContextFrame.timeline.value};
+        const auto signalValues = array {renderContextFrame.timeline.value, u64 {0}};
 
-        const auto presentInfoCfg = PresentInfoCfg {.semaphoresWait = array {renderContextFrame.semaphore.graphics},
+        auto timelineSubmitInfo = getTimelineSubmitInfo({.valuesWait = span {waitValues}.first(waitCount), .valuesSignal = signalValues});
+
+        const auto submitInfoCfg = SubmitInfoCfg {.stages           = span {waitStages}.first(waitCount),
+                                                  .semaphoresWait   = span {waitSemaphores}.first(waitCount),
+                                                  .semaphoresSignal = signalSemaphores,
+                                                  .commandBuffers   = array {renderContextFrame.commandBuffer.graphics[0]},
+                                                  .next             = &timelineSubmitInfo};
+
+        const auto presentInfoCfg = PresentInfoCfg {.semaphoresWait = array {renderContext.semaphore.rendered[imageIndex]},
                                                     .swapchains     = array {objects.swapchain.handle},
-                                                    .images         = array {static_cast<u32>(frameIndex)}};
+                                                    .images         = array {static_cast<u32>(imageIndex)}};
 
         const auto submitInfos = array {getSubmitInfo(submitInfoCfg)};
         const auto presentInfo = getPresentInfo(presentInfoCfg);
 
-        vkQueueSubmit(renderContext.queue.graphics[0], submitInfos.size(), submitInfos.data(), renderContextFrame.fence.rendered);
+        vkQueueSubmit(renderContext.queue.graphics[0], submitInfos.size(), submitInfos.data(), VK_NULL_HANDLE);
         vkQueuePresentKHR(renderContext.queue.swapchain[0], &presentInfo);
     }
 
+    std::optional<RenderContext>&
+    getDrawContext() noexcept
+    {
+        static auto renderContext = std::optional<RenderContext> {};
+
+        return renderContext;
+    }
+
     void
     draw(Objects& objects, const f64 dt) noexcept(ND_VK_ASSERT_NOTHROW&& ND_ASSERT_NOTHROW)
     {
         ND_SET_SCOPE();
 
-        const auto threadCount = 1;
-        const auto frameCount  = objects.swapchainImages.size();
+        const auto frameCount  = objects.frameCount;
+        const auto threadCount = objects.commandPool.graphics.size() / frameCount;
 
-        static auto index  = 0U;
-        static auto loaded = false;
+        static auto frameIndex = u16 {0};
+        static auto loaded     = false;
 
-        static const auto renderContext = getRenderContext(objects,
-                                                           {.graphicsCount = 1, .transferCount = 1, .computeCount = 1},
-                                                           threadCount,
-                                                           frameCount);
+        auto& drawContext = getDrawContext();
 
-        const auto frameIndex = getNextImageIndex(objects.device.handle, objects.swapchain.handle, renderContext.semaphore.acquired[index]);
+        if(!drawContext.has_value())
+        {
+            drawContext.emplace(
+                getRenderContext(objects, {.graphicsCount = 1, .transferCount = 1, .computeCount = 1}, "assets/scene.ndm", frameCount));
+        }
+
+        auto& renderContext = drawContext.value();
+
+        const auto hostAllocation = getHostAllocationSnapshot();
 
         const auto renderContextFrame = getRenderContextFrame(renderContext,
                                                               {.graphicsCount = 1, .transferCount = 1, .computeCount = 1},
@@ -298,20 +881,64 @@ namespace nd::src::graphics
                                                               frameCount,
                                                               frameIndex);
 
-        vkWaitForFences(objects.device.handle, 1, &renderContextFrame.fence.rendered, VK_TRUE, std::numeric_limits<u64>::max());
-        vkResetFences(objects.device.handle, 1, &renderContextFrame.fence.rendered);
+        setTimelineWait(objects.device.handle, renderContext.timeline.graphics, renderContextFrame.timeline.valueWait);
+
+        const auto imageIndex = getNextImageIndex(objects.device.handle, objects.swapchain.handle, renderContextFrame.semaphore.acquired);
+
+        resetTransientAllocator(renderContext.transient, frameIndex);
+        resetDefragmenter(renderContext.defragmenter, frameIndex, objects.device.handle);
+        resetGeometry(renderContext.geometry, frameIndex, objects.device.handle);
+
+        renderContext.memoryBudget = getMemoryBudget(objects.physicalDevice, objects.device.extensions);
 
         resetCommandPools(span {objects.commandPool.graphics}.subspan(frameIndex * threadCount, threadCount), objects.device.handle);
         resetCommandPools(span {objects.commandPool.transfer}.subspan(frameIndex * threadCount, threadCount), objects.device.handle);
         resetCommandPools(span {objects.commandPool.compute}.subspan(frameIndex * threadCount, threadCount), objects.device.handle);
 
-        const auto scene        = getScene(objects, dt);
-        const auto memoryLayout = getMemoryLayout(objects, dt);
+        const auto scene = getScene(objects, dt);
+        const auto view  = getView(scene.camera);
+
+        const auto streamed = setGeometryStreamBatch(renderContext.stream,
+                                                     renderContext.geometry,
+                                                     renderContext.memoryBudget,
+                                                     objects.device.handle,
+                                                     objects.physicalDevice);
+
+        const auto transferred = setTransfer(objects, scene, renderContext, renderContextFrame, frameCount, frameIndex, streamed);
+
+        setGeometryStreamSubmit(renderContext.stream, renderContext.queue.transfer[0]);
+
+        setGeometryStreamJobs(renderContext.stream, renderContext.jobs);
+
+        const auto computed = setCompute(objects, scene, renderContext, renderContextFrame, frameCount, frameIndex, transferred, view);
+
+        setGraphics(objects, scene, renderContext, renderContextFrame, frameCount, frameIndex, imageIndex, transferred, computed, view);
+
+        renderContext.hostAllocation = getHostAllocationDelta(hostAllocation, getHostAllocationSnapshot());
+
+        frameIndex = (frameIndex + 1) % frameCount;
+
+        ++renderContext.timeline.value;
+    }
+
+    void
+    destroyDraw(const Objects& objects) noexcept
+    {
+        ND_SET_SCOPE();
+
+        auto& drawContext = getDrawContext();
+
+        if(!drawContext.has_value())
+        {
+            return;
+        }
+
+        vkDeviceWaitIdle(objects.device.handle);
+
+        auto meshFile = std::move(drawContext->meshFile);
 
-        setTransfer(objects, scene, memoryLayout, renderContext, renderContextFrame, frameCount, frameIndex, index, dt);
-        setCompute(objects, scene, memoryLayout, renderContext, renderContextFrame, frameCount, frameIndex, index, dt);
-        setGraphics(objects, scene, memoryLayout, renderContext, renderContextFrame, frameCount, frameIndex, index, dt);
+        drawContext.reset();
 
-        index = (index + 1) % frameCount;
+        destroyMeshFile(meshFile);
     }
 } // namespace nd::src::graphics
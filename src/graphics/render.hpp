@@ -9,6 +9,7 @@
 
 // nd::src::graphics
 
+#include "frustum_cull.hpp"
 #include "render_context.hpp"
 #include "scene.hpp"
 
@@ -16,4 +17,7 @@ namespace nd::src::graphics
 {
     void
     draw(vulkan::Objects&, const f64) noexcept(ND_VK_ASSERT_NOTHROW&& ND_ASSERT_NOTHROW);
+
+    void
+    destroyDraw(const vulkan::Objects&) noexcept;
 } // namespace nd::src::graphics
@@ -7,26 +7,37 @@ namespace nd::src::graphics
 
     using nd::src::graphics::vulkan::getQueue;
     using nd::src::graphics::vulkan::getQueues;
-    using nd::src::graphics::vulkan::createFence;
-    using nd::src::graphics::vulkan::createFences;
-    using nd::src::graphics::vulkan::createSemaphore;
     using nd::src::graphics::vulkan::createSemaphores;
+    using nd::src::graphics::vulkan::createTimeline;
     using nd::src::graphics::vulkan::allocateCommandBuffers;
     using nd::src::graphics::vulkan::allocateDescriptorSets;
+    using nd::src::graphics::vulkan::getTransientAllocator;
+    using nd::src::graphics::vulkan::getDefragmenter;
+    using nd::src::graphics::vulkan::getPhysicalDeviceProperties;
+    using nd::src::graphics::vulkan::getMemoryBudget;
 
     RenderContext
     getRenderContext(vulkan::Objects&       objects,
                      const CommandBufferCfg commandBufferCfg,
-                     const u16              threadCount,
+                     const str&             meshFilePath,
                      const u16              frameCount) noexcept(ND_VK_ASSERT_NOTHROW)
     {
         ND_SET_SCOPE();
 
+        const auto properties = getPhysicalDeviceProperties(objects.physicalDevice);
+
+        const auto transientAlignment =
+            std::max(properties.limits.minUniformBufferOffsetAlignment, properties.limits.minStorageBufferOffsetAlignment);
+
+        const auto workerCount = static_cast<u16>(std::max(2U, std::thread::hardware_concurrency()) - 1);
+
         return RenderContext {
             .semaphore     = {.acquired = createSemaphores(objects, {}, frameCount),
-                              .graphics = createSemaphores(objects, {}, frameCount),
-                              .transfer = createSemaphores(objects, {}, frameCount),
-                              .compute  = createSemaphores(objects, {}, frameCount)},
+                              .rendered = createSemaphores(objects, {}, objects.swapchainImages.size())},
+            .timeline      = {.graphics = createTimeline(objects, {}),
+                              .transfer = createTimeline(objects, {}),
+                              .compute  = createTimeline(objects, {}),
+                              .value    = 1},
             .queue         = {.graphics  = getQueues(objects.device.handle,
                                             objects.device.queueFamily.graphics.index,
                                             objects.device.queueFamily.graphics.queueCount),
@@ -37,19 +48,39 @@ namespace nd::src::graphics
                                            objects.device.queueFamily.compute.index,
                                            objects.device.queueFamily.compute.queueCount),
                               .swapchain = getQueues(objects.device.handle, objects.swapchain.queueFamily.index, objects.swapchain.queueFamily.queueCount)},
-            .commandBuffer = {.graphics = allocateCommandBuffers({.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY, .count = commandBufferCfg.graphicsCount},
-                                                                 objects.commandPool.graphics,
-                                                                 objects.device.handle),
-                              .transfer = allocateCommandBuffers({.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY, .count = commandBufferCfg.transferCount},
-                                                                 objects.commandPool.transfer,
+            .commandBuffer = {.graphics  = allocateCommandBuffers({.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY, .count = commandBufferCfg.graphicsCount},
+                                                                  objects.commandPool.graphics,
+                                                                  objects.device.handle),
+                              .transfer  = allocateCommandBuffers({.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY, .count = commandBufferCfg.transferCount},
+                                                                  objects.commandPool.transfer,
+                                                                  objects.device.handle),
+                              .compute   = allocateCommandBuffers({.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY, .count = commandBufferCfg.computeCount},
+                                                                 objects.commandPool.compute,
                                                                  objects.device.handle),
-                              .compute  = allocateCommandBuffers({.level = VK_COMMAND_BUFFER_LEVEL_PRIMARY, .count = commandBufferCfg.computeCount},
-                                                                objects.commandPool.compute,
+                              .secondary = allocateCommandBuffers({.level = VK_COMMAND_BUFFER_LEVEL_SECONDARY, .count = 1},
+                                                                  objects.commandPool.graphics,
+                                                                  objects.device.handle)},
+            .descriptorSet = {.mesh    = allocateDescriptorSets({.layouts = vec<VkDescriptorSetLayout>(frameCount, objects.descriptorSetLayout.mesh)},
+                                                                objects.descriptorPool,
+                                                                objects.device.handle),
+                              .meshlet = allocateDescriptorSets(
+                                  {.layouts = vec<VkDescriptorSetLayout>(frameCount, objects.descriptorSetLayout.meshlet)},
+                                  objects.descriptorPool,
+                                  objects.device.handle),
+                              .draw    = allocateDescriptorSets({.layouts = vec<VkDescriptorSetLayout>(frameCount, objects.descriptorSetLayout.draw)},
+                                                                objects.descriptorPool,
                                                                 objects.device.handle)},
-            .descriptorSet = {.mesh = allocateDescriptorSets({.layouts = vec<VkDescriptorSetLayout>(frameCount, objects.descriptorSetLayout.mesh)},
-                                                             objects.descriptorPool,
-                                                             objects.device.handle)},
-            .fence         = {.rendered = createFences(objects, {.flags = VK_FENCE_CREATE_SIGNALED_BIT}, frameCount)}};
+            .meshFile      = createMeshFile(meshFilePath, vulkan::vertexFormat),
+            .geometry      = getGeometry(objects.buffer.mesh, vulkan::vertexFormat, 2.0f, frameCount),
+            .stream        = getGeometryStream(objects, vulkan::vertexFormat, frameCount),
+            .transient     = getTransientAllocator(objects.buffer.transient, transientAlignment, frameCount),
+            .defragmenter  = getDefragmenter(objects.device.memory.device,
+                                            array {&objects.buffer.mesh},
+                                            1024 * 1024,
+                                            0.25f,
+                                            frameCount),
+            .memoryBudget  = getMemoryBudget(objects.physicalDevice, objects.device.extensions),
+            .jobs          = getJobSystem(workerCount)};
     }
 
     RenderContext::Frame
@@ -70,13 +101,16 @@ namespace nd::src::graphics
         const auto computeCount  = threadCount * commandBufferCfg.computeCount;
         const auto computeOffset = computeCount * frameIndex;
 
-        return RenderContext::Frame {.commandBuffer = {.graphics = span {renderContext.commandBuffer.graphics}.subspan(graphicsOffset, graphicsCount),
-                                                       .transfer = span {renderContext.commandBuffer.transfer}.subspan(transferOffset, transferCount),
-                                                       .compute  = span {renderContext.commandBuffer.compute}.subspan(computeOffset, computeCount)},
-                                     .semaphore     = {.graphics = renderContext.semaphore.graphics[frameIndex],
-                                                       .transfer = renderContext.semaphore.transfer[frameIndex],
-                                                       .compute  = renderContext.semaphore.compute[frameIndex]},
-                                     .fence         = {.rendered = renderContext.fence.rendered[frameIndex]},
-                                     .descriptorSet = {.mesh = renderContext.descriptorSet.mesh[frameIndex]}};
+        return RenderContext::Frame {
+            .commandBuffer = {.graphics  = span {renderContext.commandBuffer.graphics}.subspan(graphicsOffset, graphicsCount),
+                              .transfer  = span {renderContext.commandBuffer.transfer}.subspan(transferOffset, transferCount),
+                              .compute   = span {renderContext.commandBuffer.compute}.subspan(computeOffset, computeCount),
+                              .secondary = span {renderContext.commandBuffer.secondary}.subspan(threadCount * frameIndex, threadCount)},
+            .semaphore     = {.acquired = renderContext.semaphore.acquired[frameIndex]},
+            .timeline      = {.value     = renderContext.timeline.value,
+                              .valueWait = renderContext.timeline.value > frameCount ? renderContext.timeline.value - frameCount : 0},
+            .descriptorSet = {.mesh    = renderContext.descriptorSet.mesh[frameIndex],
+                              .meshlet = renderContext.descriptorSet.meshlet[frameIndex],
+                              .draw    = renderContext.descriptorSet.draw[frameIndex]}};
     }
 } // namespace nd::src::graphics
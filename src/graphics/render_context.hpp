@@ -2,11 +2,17 @@
 
 #include "pch.hpp"
 #include "tools.hpp"
+#include "job.hpp"
 
 // nd::src::graphics::vulkan
 
 #include "objects_complete.hpp"
 
+// nd::src::graphics
+
+#include "geometry.hpp"
+#include "geometry_stream.hpp"
+
 namespace nd::src::graphics
 {
     struct QueueObjects final
@@ -29,24 +35,31 @@ namespace nd::src::graphics
         vec<vulkan::CommandBuffer> graphics;
         vec<vulkan::CommandBuffer> transfer;
         vec<vulkan::CommandBuffer> compute;
+
+        vec<vulkan::CommandBuffer> secondary;
     };
 
     struct DescriptorSetObjects final
     {
         vec<vulkan::DescriptorSet> mesh;
+        vec<vulkan::DescriptorSet> meshlet;
+        vec<vulkan::DescriptorSet> draw;
     };
 
     struct SemaphoreObjects final
     {
         vec<vulkan::Semaphore> acquired;
-        vec<vulkan::Semaphore> graphics;
-        vec<vulkan::Semaphore> transfer;
-        vec<vulkan::Semaphore> compute;
+
+        vec<vulkan::Semaphore> rendered;
     };
 
-    struct FenceObjects final
+    struct TimelineObjects final
     {
-        vec<vulkan::Fence> rendered;
+        vulkan::Semaphore graphics;
+        vulkan::Semaphore transfer;
+        vulkan::Semaphore compute;
+
+        u64 value;
     };
 
     struct CommandBufferView final
@@ -54,23 +67,26 @@ namespace nd::src::graphics
         span<const vulkan::CommandBuffer> graphics;
         span<const vulkan::CommandBuffer> transfer;
         span<const vulkan::CommandBuffer> compute;
+        span<const vulkan::CommandBuffer> secondary;
     };
 
     struct DescriptorSetView final
     {
         vulkan::DescriptorSet mesh;
+        vulkan::DescriptorSet meshlet;
+        vulkan::DescriptorSet draw;
     };
 
     struct SemaphoreView final
     {
-        vulkan::Semaphore graphics;
-        vulkan::Semaphore transfer;
-        vulkan::Semaphore compute;
+        vulkan::Semaphore acquired;
     };
 
-    struct FenceView final
+    struct TimelineView final
     {
-        vulkan::Fence rendered;
+        u64 value;
+
+        u64 valueWait;
     };
 
     struct RenderContext final
@@ -79,21 +95,34 @@ namespace nd::src::graphics
         {
             CommandBufferView commandBuffer;
             SemaphoreView     semaphore;
-            FenceView         fence;
+            TimelineView      timeline;
             DescriptorSetView descriptorSet;
         };
 
         SemaphoreObjects semaphore;
+        TimelineObjects  timeline;
 
         QueueObjects         queue;
         CommandBufferObjects commandBuffer;
         DescriptorSetObjects descriptorSet;
 
-        FenceObjects fence;
+        MeshFile                   meshFile;
+        Geometry                   geometry;
+        GeometryStream             stream;
+        vulkan::TransientAllocator transient;
+        vulkan::Defragmenter       defragmenter;
+        vulkan::MemoryBudget       memoryBudget;
+
+        vulkan::HostAllocationSnapshot hostAllocation;
+
+        // after the stream, so its workers are joined first
+        tools::JobSystem jobs;
+
+        vec<std::optional<VkDeviceSize>> meshletCommands;
     };
 
     RenderContext
-    getRenderContext(vulkan::Objects&, const CommandBufferCfg, const u16, const u16) noexcept(ND_VK_ASSERT_NOTHROW);
+    getRenderContext(vulkan::Objects&, const CommandBufferCfg, const str&, const u16) noexcept(ND_VK_ASSERT_NOTHROW);
 
     RenderContext::Frame
     getRenderContextFrame(const RenderContext&, const CommandBufferCfg, const u16, const u16, const u16) noexcept;
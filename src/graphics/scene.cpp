@@ -4,4 +4,34 @@
 namespace nd::src::graphics
 {
     using namespace nd::src::tools;
+
+    glm::mat4
+    getTransformMatrix(const Transform& transform) noexcept
+    {
+        ND_SET_SCOPE();
+
+        const auto translation = glm::translate(glm::mat4(1.0f), transform.translation);
+        const auto rotationZ   = glm::rotate(translation, transform.rotation.z, glm::vec3(0.0f, 0.0f, 1.0f));
+        const auto rotationY   = glm::rotate(rotationZ, transform.rotation.y, glm::vec3(0.0f, 1.0f, 0.0f));
+        const auto rotationX   = glm::rotate(rotationY, transform.rotation.x, glm::vec3(1.0f, 0.0f, 0.0f));
+
+        return glm::scale(rotationX, transform.scalation);
+    }
+
+    array<glm::vec4, 6>
+    getFrustumPlanes(const glm::mat4& matrix) noexcept
+    {
+        ND_SET_SCOPE();
+
+        const auto rows = glm::transpose(matrix);
+
+        auto planes = array {rows[3] + rows[0], rows[3] - rows[0], rows[3] + rows[1], rows[3] - rows[1], rows[3] + rows[2], rows[3] - rows[2]};
+
+        for(auto& plane: planes)
+        {
+            plane /= glm::length(glm::vec3(plane));
+        }
+
+        return planes;
+    }
 } // namespace nd::src::graphics
@@ -5,7 +5,7 @@
 
 namespace nd::src::graphics
 {
-    using Index = u16;
+    using Index = u32;
 
     struct Vertex final
     {
@@ -13,6 +13,12 @@ namespace nd::src::graphics
         glm::vec3 color;
     };
 
+    struct VertexQuantized final
+    {
+        array<i16, 4> position;
+        array<u8, 4>  color;
+    };
+
     struct Transform final
     {
         glm::vec3 rotation;
@@ -32,10 +38,35 @@ namespace nd::src::graphics
         f32 far;
     };
 
+    struct MeshLod final
+    {
+        vec<Index> indices;
+
+        f32 error;
+    };
+
+    struct Meshlet final
+    {
+        u32 firstIndex;
+        u32 indexCount;
+
+        glm::vec3 center;
+        f32       radius;
+
+        glm::vec3 coneAxis;
+        f32       coneCutoff;
+    };
+
     struct Mesh final
     {
         vec<Index>  indices;
         vec<Vertex> vertices;
+
+        vec<MeshLod> lods;
+        vec<Meshlet> meshlets;
+
+        // zero marks an empty slot
+        u64 version;
     };
 
     struct Instance final
@@ -52,4 +83,11 @@ namespace nd::src::graphics
         vec<Mesh>     meshes;
         vec<Instance> instances;
     };
+
+    glm::mat4
+    getTransformMatrix(const Transform&) noexcept;
+
+    // left, right, bottom, top, near, far
+    array<glm::vec4, 6>
+    getFrustumPlanes(const glm::mat4&) noexcept;
 } // namespace nd::src::graphics
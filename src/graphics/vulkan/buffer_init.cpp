@@ -24,9 +24,24 @@ namespace nd::src::graphics::vulkan
 
         ND_VK_ASSERT(vkCreateBuffer(device, &createInfo, ND_VK_ALLOCATION_CALLBACKS, &buffer));
 
-        const auto offset = bindBufferMemory(buffer, cfg.memory, device, physicalDevice);
+        const auto binding = bindBufferMemory(buffer, cfg.memory, device, physicalDevice);
+
+        return {.memory             = binding.memory,
+                .offset             = binding.offset,
+                .size               = cfg.size,
+                .usage              = cfg.usage,
+                .handle             = buffer,
+                .queueFamilyIndices = cfg.queueFamilyIndices};
+    }
+
+    void
+    destroyBuffer(opt<const Buffer>::ref buffer, const VkDevice device) noexcept(ND_ASSERT_NOTHROW)
+    {
+        ND_SET_SCOPE();
+
+        vkDestroyBuffer(device, buffer.handle, ND_VK_ALLOCATION_CALLBACKS);
 
-        return {.offset = offset, .handle = buffer};
+        unbindMemory(buffer.memory, buffer.offset, device);
     }
 
     BufferObjects
@@ -36,6 +51,10 @@ namespace nd::src::graphics::vulkan
     {
         ND_SET_SCOPE();
 
-        return {.mesh = createBuffer(cfg.mesh, device, physicalDevice), .stage = createBuffer(cfg.stage, device, physicalDevice)};
+        return {.mesh      = createBuffer(cfg.mesh, device, physicalDevice),
+                .transient = createBuffer(cfg.transient, device, physicalDevice),
+                .cull      = createBuffer(cfg.cull, device, physicalDevice),
+                .draw      = createBuffer(cfg.draw, device, physicalDevice),
+                .stream    = createBuffer(cfg.stream, device, physicalDevice)};
     }
 } // namespace nd::src::graphics::vulkan
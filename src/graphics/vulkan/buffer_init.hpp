@@ -9,6 +9,9 @@ namespace nd::src::graphics::vulkan
     Buffer
     createBuffer(opt<const BufferCfg>::ref, const VkDevice, const VkPhysicalDevice) noexcept(ND_VK_ASSERT_NOTHROW);
 
+    void
+    destroyBuffer(opt<const Buffer>::ref, const VkDevice) noexcept(ND_ASSERT_NOTHROW);
+
     BufferObjects
     createBufferObjects(opt<const BufferObjectsCfg>::ref, const VkDevice, const VkPhysicalDevice) noexcept(ND_VK_ASSERT_NOTHROW);
 } // namespace nd::src::graphics::vulkan
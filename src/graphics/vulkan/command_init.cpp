@@ -52,7 +52,8 @@ namespace nd::src::graphics::vulkan
 
         return {.graphics = createCommandPools(cfg.graphics, device),
                 .transfer = createCommandPools(cfg.transfer, device),
-                .compute  = createCommandPools(cfg.compute, device)};
+                .compute  = createCommandPools(cfg.compute, device),
+                .stream   = createCommandPools(cfg.stream, device)};
     }
 
     vec<CommandBuffer>
@@ -0,0 +1,211 @@
+#include "defragment.hpp"
+#include "buffer_init.hpp"
+#include "tools_runtime.hpp"
+
+namespace nd::src::graphics::vulkan
+{
+    using namespace nd::src::tools;
+
+    void
+    updateDefragmentBinding(opt<const DefragmentBinding>::ref binding, const VkDevice device) noexcept
+    {
+        const auto bufferInfo = VkDescriptorBufferInfo {.buffer = binding.handle, .offset = binding.offset, .range = binding.range};
+
+        const auto write = VkWriteDescriptorSet {.sType            = VK_STRUCTURE_TYPE_WRITE_DESCRIPTOR_SET,
+                                                 .pNext            = {},
+                                                 .dstSet           = binding.set,
+                                                 .dstBinding       = binding.binding,
+                                                 .dstArrayElement  = 0,
+                                                 .descriptorCount  = 1,
+                                                 .descriptorType   = binding.type,
+                                                 .pImageInfo       = {},
+                                                 .pBufferInfo      = &bufferInfo,
+                                                 .pTexelBufferView = {}};
+
+        vkUpdateDescriptorSets(device, 1, &write, 0, nullptr);
+    }
+
+    std::optional<Buffer>
+    getDefragmentTarget(opt<const Buffer>::ref source, const VkDevice device, const VkPhysicalDevice physicalDevice) noexcept(ND_VK_ASSERT_NOTHROW)
+    {
+        const auto createInfo = VkBufferCreateInfo {.sType                 = VK_STRUCTURE_TYPE_BUFFER_CREATE_INFO,
+                                                    .pNext                 = {},
+                                                    .flags                 = {},
+                                                    .size                  = source.size,
+                                                    .usage                 = source.usage,
+                                                    .sharingMode           = source.queueFamilyIndices.size() > 1 ? VK_SHARING_MODE_CONCURRENT
+                                                                                                                  : VK_SHARING_MODE_EXCLUSIVE,
+                                                    .queueFamilyIndexCount = static_cast<u32>(source.queueFamilyIndices.size()),
+                                                    .pQueueFamilyIndices   = source.queueFamilyIndices.data()};
+
+        VkBuffer buffer;
+
+        ND_VK_ASSERT(vkCreateBuffer(device, &createInfo, ND_VK_ALLOCATION_CALLBACKS, &buffer));
+
+        const auto requirements = getBufferMemoryRequirements(buffer, device);
+        const auto offset       = allocateMemoryOffset(source.memory, requirements, MemoryBlockType::linear, physicalDevice);
+
+        if(offset.has_value() && offset.value() < source.offset)
+        {
+            ND_VK_ASSERT(vkBindBufferMemory(device, buffer, source.memory.handle, offset.value()));
+
+            return Buffer {.memory             = source.memory,
+                           .offset             = offset.value(),
+                           .size               = source.size,
+                           .usage              = source.usage,
+                           .handle             = buffer,
+                           .queueFamilyIndices = source.queueFamilyIndices};
+        }
+
+        if(offset.has_value())
+        {
+            unbindMemory(source.memory, offset.value(), device);
+        }
+
+        vkDestroyBuffer(device, buffer, ND_VK_ALLOCATION_CALLBACKS);
+
+        return std::nullopt;
+    }
+
+    Defragmenter
+    getDefragmenter(opt<const DeviceMemory>::ref memory,
+                    const span<Buffer* const>    buffers,
+                    const VkDeviceSize           frameBudget,
+                    const f32                    fragmentationMin,
+                    const u16                    frameCount) noexcept
+    {
+        ND_SET_SCOPE();
+
+        const auto usage = VkBufferUsageFlags {VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT};
+
+        const auto memoryBuffers = getFiltered<Buffer*>(buffers,
+                                                        [&memory, usage](const auto buffer, const auto index)
+                                                        {
+                                                            return buffer->memory.handle == memory.handle && isContainsAll(buffer->usage, usage);
+                                                        });
+
+        return {.memory           = memory,
+                .frameBudget      = frameBudget,
+                .fragmentationMin = fragmentationMin,
+                .buffers          = memoryBuffers,
+                .bindings         = {},
+                .moves            = {},
+                .frameBuffers     = vec<vec<Buffer>>(frameCount)};
+    }
+
+    void
+    setDefragmentBinding(Defragmenter& defragmenter, const DefragmentBinding& binding, const VkDevice device) noexcept
+    {
+        ND_SET_SCOPE();
+
+        auto& bound = defragmenter.bindings.emplace_back(binding);
+
+        bound.handle = bound.buffer->handle;
+
+        updateDefragmentBinding(bound, device);
+    }
+
+    void
+    setDefragmentBindings(Defragmenter& defragmenter, const u16 frameIndex, const VkDevice device) noexcept
+    {
+        ND_SET_SCOPE();
+
+        for(auto& binding: defragmenter.bindings)
+        {
+            if(binding.frameIndex == frameIndex && binding.handle != binding.buffer->handle)
+            {
+                binding.handle = binding.buffer->handle;
+
+                updateDefragmentBinding(binding, device);
+            }
+        }
+    }
+
+    bool
+    getDefragmentMoves(Defragmenter&          defragmenter,
+                       const VkDevice         device,
+                       const VkPhysicalDevice physicalDevice) noexcept(ND_VK_ASSERT_NOTHROW&& ND_ASSERT_NOTHROW)
+    {
+        ND_SET_SCOPE();
+
+        if(getMemoryStats(defragmenter.memory).fragmentation < defragmenter.fragmentationMin)
+        {
+            return false;
+        }
+
+        auto buffers = defragmenter.buffers;
+
+        std::sort(buffers.begin(),
+                  buffers.end(),
+                  [](const auto buffer1, const auto buffer2)
+                  {
+                      return buffer1->offset > buffer2->offset;
+                  });
+
+        auto budget = defragmenter.frameBudget;
+
+        for(const auto buffer: buffers)
+        {
+            if(buffer->size > budget || buffer->memory.handle != defragmenter.memory.handle)
+            {
+                continue;
+            }
+
+            const auto target = getDefragmentTarget(*buffer, device, physicalDevice);
+
+            if(!target.has_value())
+            {
+                continue;
+            }
+
+            defragmenter.moves.push_back({.source = *buffer, .target = target.value()});
+
+            *buffer = target.value();
+            budget -= buffer->size;
+        }
+
+        return !defragmenter.moves.empty();
+    }
+
+    void
+    setDefragmentCopies(Defragmenter& defragmenter, const VkCommandBuffer commandBuffer, const u16 frameIndex) noexcept
+    {
+        ND_SET_SCOPE();
+
+        if(defragmenter.moves.empty())
+        {
+            return;
+        }
+
+        const auto barrier = VkMemoryBarrier {.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+                                              .pNext         = {},
+                                              .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+                                              .dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT};
+
+        vkCmdPipelineBarrier(commandBuffer, VK_PIPELINE_STAGE_TRANSFER_BIT, VK_PIPELINE_STAGE_TRANSFER_BIT, {}, 1, &barrier, 0, nullptr, 0, nullptr);
+
+        for(const auto& move: defragmenter.moves)
+        {
+            const auto copy = VkBufferCopy {.srcOffset = 0, .dstOffset = 0, .size = move.source.size};
+
+            vkCmdCopyBuffer(commandBuffer, move.source.handle, move.target.handle, 1, &copy);
+
+            defragmenter.frameBuffers[frameIndex].push_back(move.source);
+        }
+
+        defragmenter.moves.clear();
+    }
+
+    void
+    resetDefragmenter(Defragmenter& defragmenter, const u16 frameIndex, const VkDevice device) noexcept(ND_ASSERT_NOTHROW)
+    {
+        ND_SET_SCOPE();
+
+        for(const auto& buffer: defragmenter.frameBuffers[frameIndex])
+        {
+            destroyBuffer(buffer, device);
+        }
+
+        defragmenter.frameBuffers[frameIndex].clear();
+    }
+} // namespace nd::src::graphics::vulkan
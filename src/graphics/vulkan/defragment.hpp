@@ -0,0 +1,56 @@
+#pragma once
+
+#include "shared_init.hpp"
+
+namespace nd::src::graphics::vulkan
+{
+    struct DefragmentMove final
+    {
+        Buffer source;
+        Buffer target;
+    };
+
+    struct DefragmentBinding final
+    {
+        const Buffer* buffer;
+
+        VkDescriptorSet  set;
+        u32              binding;
+        VkDescriptorType type;
+        VkDeviceSize     offset;
+        VkDeviceSize     range;
+
+        VkBuffer handle;
+        u16      frameIndex;
+    };
+
+    struct Defragmenter final
+    {
+        DeviceMemory memory;
+        VkDeviceSize frameBudget;
+        f32          fragmentationMin;
+
+        vec<Buffer*>           buffers;
+        vec<DefragmentBinding> bindings;
+        vec<DefragmentMove>    moves;
+        vec<vec<Buffer>>       frameBuffers;
+    };
+
+    Defragmenter
+    getDefragmenter(opt<const DeviceMemory>::ref, const span<Buffer* const>, const VkDeviceSize, const f32, const u16) noexcept;
+
+    void
+    setDefragmentBinding(Defragmenter&, const DefragmentBinding&, const VkDevice) noexcept;
+
+    void
+    setDefragmentBindings(Defragmenter&, const u16, const VkDevice) noexcept;
+
+    bool
+    getDefragmentMoves(Defragmenter&, const VkDevice, const VkPhysicalDevice) noexcept(ND_VK_ASSERT_NOTHROW&& ND_ASSERT_NOTHROW);
+
+    void
+    setDefragmentCopies(Defragmenter&, const VkCommandBuffer, const u16) noexcept;
+
+    void
+    resetDefragmenter(Defragmenter&, const u16, const VkDevice) noexcept(ND_ASSERT_NOTHROW);
+} // namespace nd::src::graphics::vulkan
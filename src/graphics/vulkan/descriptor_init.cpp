@@ -47,7 +47,9 @@ namespace nd::src::graphics::vulkan
     {
         ND_SET_SCOPE();
 
-        return {.mesh = createDescriptorSetLayout(cfg.mesh, device)};
+        return {.mesh    = createDescriptorSetLayout(cfg.mesh, device),
+                .meshlet = createDescriptorSetLayout(cfg.meshlet, device),
+                .draw    = createDescriptorSetLayout(cfg.draw, device)};
     }
 
     vec<DescriptorSet>
@@ -85,6 +85,21 @@ namespace nd::src::graphics::vulkan
         return features;
     }
 
+    VkPhysicalDeviceVulkan12Features
+    getPhysicalDeviceFeatures12(const VkPhysicalDevice physicalDevice) noexcept
+    {
+        ND_SET_SCOPE();
+
+        auto features12 = VkPhysicalDeviceVulkan12Features {.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES};
+        auto features   = VkPhysicalDeviceFeatures2 {.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_FEATURES_2, .pNext = &features12};
+
+        vkGetPhysicalDeviceFeatures2(physicalDevice, &features);
+
+        features12.pNext = {};
+
+        return features12;
+    }
+
     VkPhysicalDeviceProperties
     getPhysicalDeviceProperties(const VkPhysicalDevice physicalDevice) noexcept
     {
@@ -97,6 +112,21 @@ namespace nd::src::graphics::vulkan
         return properties;
     }
 
+    VkPhysicalDeviceSubgroupProperties
+    getPhysicalDeviceSubgroupProperties(const VkPhysicalDevice physicalDevice) noexcept
+    {
+        ND_SET_SCOPE();
+
+        auto subgroupProperties = VkPhysicalDeviceSubgroupProperties {.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_SUBGROUP_PROPERTIES};
+        auto properties         = VkPhysicalDeviceProperties2 {.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_PROPERTIES_2, .pNext = &subgroupProperties};
+
+        vkGetPhysicalDeviceProperties2(physicalDevice, &properties);
+
+        subgroupProperties.pNext = {};
+
+        return subgroupProperties;
+    }
+
     bool
     isPhysicalDeviceExtensionsSupported(const VkPhysicalDevice physicalDevice, const vec<str>& extensions) noexcept(ND_VK_ASSERT_NOTHROW)
     {
@@ -117,6 +147,20 @@ namespace nd::src::graphics::vulkan
                            });
     }
 
+    bool
+    isFeaturesContained(const VkBool32* features, const VkBool32* featuresSupported, const u64 count) noexcept
+    {
+        for(u64 index = 0; index < count; ++index)
+        {
+            if(features[index] && !featuresSupported[index])
+            {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
     bool
     isPhysicalDeviceFeaturesSupported(const VkPhysicalDevice physicalDevice, const VkPhysicalDeviceFeatures& features) noexcept
     {
@@ -124,28 +168,35 @@ namespace nd::src::graphics::vulkan
 
         const auto physicalDeviceFeatures = getPhysicalDeviceFeatures(physicalDevice);
 
-        auto shift = 0ULL;
+        return isFeaturesContained(reinterpret_cast<const VkBool32*>(&features),
+                                   reinterpret_cast<const VkBool32*>(&physicalDeviceFeatures),
+                                   sizeof(VkPhysicalDeviceFeatures) / sizeof(VkBool32));
+    }
 
-        const auto step = sizeof(VkBool32);
-        const auto size = sizeof(VkPhysicalDeviceFeatures);
+    bool
+    isPhysicalDeviceFeatures12Supported(const VkPhysicalDevice physicalDevice, const VkPhysicalDeviceVulkan12Features& features12) noexcept
+    {
+        ND_SET_SCOPE();
 
-        const auto featuresPtr               = &features;
-        const auto physicalDeviceFeaturesPtr = &physicalDeviceFeatures;
+        const auto physicalDeviceFeatures12 = getPhysicalDeviceFeatures12(physicalDevice);
 
-        while(shift * step < size)
-        {
-            const auto feature               = *(reinterpret_cast<const VkBool32*>(featuresPtr) + shift);
-            const auto physicalDeviceFeature = *(reinterpret_cast<const VkBool32*>(physicalDeviceFeaturesPtr) + shift);
+        // the flags start after the structure's type and chain pointer
+        const auto offset = offsetof(VkPhysicalDeviceVulkan12Features, samplerMirrorClampToEdge);
 
-            if(feature && !physicalDeviceFeature)
-            {
-                return false;
-            }
+        return isFeaturesContained(reinterpret_cast<const VkBool32*>(reinterpret_cast<const std::byte*>(&features12) + offset),
+                                   reinterpret_cast<const VkBool32*>(reinterpret_cast<const std::byte*>(&physicalDeviceFeatures12) + offset),
+                                   (sizeof(VkPhysicalDeviceVulkan12Features) - offset) / sizeof(VkBool32));
+    }
 
-            ++shift;
-        }
+    bool
+    isPhysicalDeviceSubgroupSupported(const VkPhysicalDevice physicalDevice, const VkSubgroupFeatureFlags subgroupOperations) noexcept
+    {
+        ND_SET_SCOPE();
 
-        return true;
+        const auto subgroupProperties = getPhysicalDeviceSubgroupProperties(physicalDevice);
+
+        return !subgroupOperations || (isContainsAll(subgroupProperties.supportedStages, VK_SHADER_STAGE_COMPUTE_BIT) &&
+                                       isContainsAll(subgroupProperties.supportedOperations, subgroupOperations));
     }
 
     bool
@@ -182,8 +233,10 @@ namespace nd::src::graphics::vulkan
             const auto priority   = cfg.priority(features, properties);
 
             if(isPhysicalDeviceExtensionsSupported(physicalDevice, cfg.extensions) &&
-               isPhysicalDeviceFeaturesSupported(physicalDevice, cfg.features) && isPhysicalDeviceQueuesSupported(physicalDevice, cfg.queueFlags) &&
-               physicalDevicePriorityMax < priority)
+               isPhysicalDeviceFeaturesSupported(physicalDevice, cfg.features) &&
+               isPhysicalDeviceFeatures12Supported(physicalDevice, cfg.features12) &&
+               isPhysicalDeviceSubgroupSupported(physicalDevice, cfg.subgroupOperations) &&
+               isPhysicalDeviceQueuesSupported(physicalDevice, cfg.queueFlags) && physicalDevicePriorityMax < priority)
             {
                 physicalDeviceMax         = physicalDevice;
                 physicalDevicePriorityMax = priority;
@@ -200,7 +253,14 @@ namespace nd::src::graphics::vulkan
     {
         ND_SET_SCOPE();
 
-        const auto cextensions   = getRawStrings(cfg.extensions);
+        const auto extensionsOptional = getFiltered<str>(cfg.extensionsOptional,
+                                                         [physicalDevice](const auto& extension, const auto index)
+                                                         {
+                                                             return isPhysicalDeviceExtensionsSupported(physicalDevice, {extension});
+                                                         });
+
+        const auto extensions    = getMerged(cfg.extensions, extensionsOptional);
+        const auto cextensions   = getRawStrings(extensions);
         const auto queueFamilies = getPhysicalDeviceQueueFamilyProperties(physicalDevice, cfg.queueFlags);
 
         const auto cextensionsSize   = static_cast<u32>(cextensions.size());
@@ -225,8 +285,13 @@ namespace nd::src::graphics::vulkan
                                                                 .pQueuePriorities = queuePriorities[index].data()});
         }
 
+        auto features12 = cfg.features12;
+
+        features12.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES;
+        features12.pNext = cfg.next;
+
         const auto createInfo = VkDeviceCreateInfo {.sType                   = VK_STRUCTURE_TYPE_DEVICE_CREATE_INFO,
-                                                    .pNext                   = cfg.next,
+                                                    .pNext                   = &features12,
                                                     .flags                   = cfg.flags,
                                                     .queueCreateInfoCount    = queueFamiliesSize,
                                                     .pQueueCreateInfos       = queueCreateInfos.data(),
@@ -242,11 +307,31 @@ namespace nd::src::graphics::vulkan
 
         const auto memoryProperties = getMemoryProperties(physicalDevice);
 
-        return {.memory      = {.device = allocateMemory(cfg.memory.device, memoryProperties, device),
-                                .host   = allocateMemory(cfg.memory.host, memoryProperties, device)},
-                .queueFamily = {.graphics = getQueueFamily(cfg.queueFamily.graphics, queueFamilies),
-                                .transfer = getQueueFamily(cfg.queueFamily.transfer, queueFamilies),
-                                .compute  = getQueueFamily(cfg.queueFamily.compute, queueFamilies)},
+        auto memoryBudget = getMemoryBudget(physicalDevice, extensions);
+
+        const auto graphics = getQueueFamily(cfg.queueFamily.graphics, queueFamilies);
+        const auto compute  = getQueueFamily(cfg.queueFamily.compute, queueFamilies);
+
+        const auto transfer = getQueueFamily(cfg.queueFamily.transfer, queueFamilies);
+
+        const auto graphicsCompute = graphics.index == compute.index ? vec<u32> {graphics.index} : vec<u32> {graphics.index, compute.index};
+
+        auto transferGraphicsCompute = graphicsCompute;
+
+        if(std::find(graphicsCompute.begin(), graphicsCompute.end(), transfer.index) == graphicsCompute.end())
+        {
+            transferGraphicsCompute.push_back(transfer.index);
+        }
+
+        return {.memory      = {.device = allocateMemory(cfg.memory.device, memoryProperties, memoryBudget, device),
+                                .host   = allocateMemory(cfg.memory.host, memoryProperties, memoryBudget, device),
+                                .mapped = allocateMemory(cfg.memory.mapped, memoryProperties, memoryBudget, device)},
+                .queueFamily = {.graphics                = graphics,
+                                .transfer                = transfer,
+                                .compute                 = compute,
+                                .graphicsCompute         = graphicsCompute,
+                                .transferGraphicsCompute = transferGraphicsCompute},
+                .extensions  = extensions,
                 .handle      = device};
     }
 } // namespace nd::src::graphics::vulkan
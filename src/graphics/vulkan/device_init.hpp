@@ -22,15 +22,27 @@ namespace nd::src::graphics::vulkan
     VkPhysicalDeviceFeatures
     getPhysicalDeviceFeatures(const VkPhysicalDevice) noexcept;
 
+    VkPhysicalDeviceVulkan12Features
+    getPhysicalDeviceFeatures12(const VkPhysicalDevice) noexcept;
+
     VkPhysicalDeviceProperties
     getPhysicalDeviceProperties(const VkPhysicalDevice) noexcept;
 
+    VkPhysicalDeviceSubgroupProperties
+    getPhysicalDeviceSubgroupProperties(const VkPhysicalDevice) noexcept;
+
     bool
     isPhysicalDeviceExtensionsSupported(const VkPhysicalDevice, const vec<str>&) noexcept(ND_VK_ASSERT_NOTHROW);
 
     bool
     isPhysicalDeviceFeaturesSupported(const VkPhysicalDevice, const VkPhysicalDeviceFeatures&) noexcept;
 
+    bool
+    isPhysicalDeviceFeatures12Supported(const VkPhysicalDevice, const VkPhysicalDeviceVulkan12Features&) noexcept;
+
+    bool
+    isPhysicalDeviceSubgroupSupported(const VkPhysicalDevice, const VkSubgroupFeatureFlags) noexcept;
+
     bool
     isPhysicalDeviceQueuesSupported(const VkPhysicalDevice, const VkQueueFlags) noexcept;
 
@@ -0,0 +1,156 @@
+#include "growable.hpp"
+#include "buffer_init.hpp"
+#include "tools_runtime.hpp"
+
+namespace nd::src::graphics::vulkan
+{
+    using namespace nd::src::tools;
+
+    void
+    setGrowableSize(GrowableBuffer&        growable,
+                    StagingRing&           ring,
+                    const VkDeviceSize     size,
+                    const VkDevice         device,
+                    const VkPhysicalDevice physicalDevice) noexcept(ND_VK_ASSERT_NOTHROW&& ND_ASSERT_NOTHROW)
+    {
+        const auto buffer      = *growable.buffer;
+        const auto sharingMode = buffer.queueFamilyIndices.size() > 1 ? VK_SHARING_MODE_CONCURRENT : VK_SHARING_MODE_EXCLUSIVE;
+        const auto target      = createBuffer({.queueFamilyIndices = buffer.queueFamilyIndices,
+                                               .memory             = buffer.memory,
+                                               .size               = size,
+                                               .usage              = buffer.usage,
+                                               .sharingMode        = sharingMode},
+                                              device,
+                                              physicalDevice);
+
+        setStagingTarget(ring, buffer.handle, target.handle);
+        setMemoryAllocatorSize(growable.allocator, size);
+
+        *growable.buffer = target;
+
+        if(growable.source.has_value())
+        {
+            destroyBuffer(buffer, device);
+
+            return;
+        }
+
+        growable.source = buffer;
+    }
+
+    GrowableBuffer
+    getGrowableBuffer(Buffer& buffer, const f32 growth, const u16 frameCount) noexcept
+    {
+        ND_SET_SCOPE();
+
+        return {.buffer       = &buffer,
+                .allocator    = getMemoryAllocator(buffer.size),
+                .growth       = growth,
+                .source       = std::nullopt,
+                .retired      = {},
+                .frameBuffers = vec<vec<Buffer>>(frameCount),
+                .released     = {},
+                .frameRanges  = vec<vec<VkDeviceSize>>(frameCount)};
+    }
+
+    VkDeviceSize
+    allocateGrowableRange(GrowableBuffer&        growable,
+                          StagingRing&           ring,
+                          const VkDeviceSize     size,
+                          const VkDeviceSize     alignment,
+                          const VkDevice         device,
+                          const VkPhysicalDevice physicalDevice) noexcept(ND_VK_ASSERT_NOTHROW&& ND_ASSERT_NOTHROW)
+    {
+        ND_SET_SCOPE();
+
+        const auto requirements = VkMemoryRequirements {.size = size, .alignment = alignment, .memoryTypeBits = ~0U};
+
+        auto offset = allocateMemoryBlock(growable.allocator, requirements, MemoryBlockType::linear, 1);
+
+        if(!offset.has_value())
+        {
+            const auto sizeGrown = static_cast<VkDeviceSize>(growable.allocator.size * growable.growth);
+            const auto sizeFit   = growable.allocator.size + size + alignment;
+
+            setGrowableSize(growable, ring, std::max(sizeGrown, sizeFit), device, physicalDevice);
+
+            offset = allocateMemoryBlock(growable.allocator, requirements, MemoryBlockType::linear, 1);
+        }
+
+        ND_ASSERT(offset.has_value());
+
+        return offset.value();
+    }
+
+    void
+    freeGrowableRange(GrowableBuffer& growable, const VkDeviceSize offset) noexcept
+    {
+        ND_SET_SCOPE();
+
+        growable.released.push_back(offset);
+    }
+
+    bool
+    isGrowablePending(const GrowableBuffer& growable) noexcept
+    {
+        ND_SET_SCOPE();
+
+        return growable.source.has_value();
+    }
+
+    void
+    setGrowableCopies(GrowableBuffer& growable, const VkCommandBuffer commandBuffer) noexcept
+    {
+        ND_SET_SCOPE();
+
+        if(!growable.source.has_value())
+        {
+            return;
+        }
+
+        const auto& source = growable.source.value();
+
+        const auto copy = VkBufferCopy {.srcOffset = 0, .dstOffset = 0, .size = source.size};
+
+        const auto sourceBarrier = VkMemoryBarrier {.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+                                                    .pNext         = {},
+                                                    .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+                                                    .dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT};
+
+        const auto targetBarrier = VkMemoryBarrier {.sType         = VK_STRUCTURE_TYPE_MEMORY_BARRIER,
+                                                    .pNext         = {},
+                                                    .srcAccessMask = VK_ACCESS_TRANSFER_WRITE_BIT,
+                                                    .dstAccessMask = VK_ACCESS_TRANSFER_READ_BIT | VK_ACCESS_TRANSFER_WRITE_BIT};
+
+        const auto stage = VkPipelineStageFlags {VK_PIPELINE_STAGE_TRANSFER_BIT};
+
+        vkCmdPipelineBarrier(commandBuffer, stage, stage, {}, 1, &sourceBarrier, 0, nullptr, 0, nullptr);
+        vkCmdCopyBuffer(commandBuffer, source.handle, growable.buffer->handle, 1, &copy);
+        vkCmdPipelineBarrier(commandBuffer, stage, stage, {}, 1, &targetBarrier, 0, nullptr, 0, nullptr);
+
+        growable.retired.push_back(source);
+        growable.source.reset();
+    }
+
+    void
+    resetGrowableBuffer(GrowableBuffer& growable, const u16 frameIndex, const VkDevice device) noexcept(ND_ASSERT_NOTHROW)
+    {
+        ND_SET_SCOPE();
+
+        for(const auto& buffer: growable.frameBuffers[frameIndex])
+        {
+            destroyBuffer(buffer, device);
+        }
+
+        for(const auto offset: growable.frameRanges[frameIndex])
+        {
+            freeMemoryBlock(growable.allocator, offset);
+        }
+
+        growable.frameBuffers[frameIndex] = std::move(growable.retired);
+        growable.frameRanges[frameIndex]  = std::move(growable.released);
+
+        growable.retired.clear();
+        growable.released.clear();
+    }
+} // namespace nd::src::graphics::vulkan
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "shared_init.hpp"
+
+#include "memory_allocator.hpp"
+#include "staging.hpp"
+
+namespace nd::src::graphics::vulkan
+{
+    struct GrowableBuffer final
+    {
+        Buffer* buffer;
+
+        MemoryAllocator allocator;
+        f32             growth;
+
+        std::optional<Buffer> source;
+
+        vec<Buffer>      retired;
+        vec<vec<Buffer>> frameBuffers;
+
+        vec<VkDeviceSize>      released;
+        vec<vec<VkDeviceSize>> frameRanges;
+    };
+
+    GrowableBuffer
+    getGrowableBuffer(Buffer&, const f32, const u16) noexcept;
+
+    VkDeviceSize
+    allocateGrowableRange(GrowableBuffer&,
+                          StagingRing&,
+                          const VkDeviceSize,
+                          const VkDeviceSize,
+                          const VkDevice,
+                          const VkPhysicalDevice) noexcept(ND_VK_ASSERT_NOTHROW&& ND_ASSERT_NOTHROW);
+
+    void
+    freeGrowableRange(GrowableBuffer&, const VkDeviceSize) noexcept;
+
+    bool
+    isGrowablePending(const GrowableBuffer&) noexcept;
+
+    void
+    setGrowableCopies(GrowableBuffer&, const VkCommandBuffer) noexcept;
+
+    void
+    resetGrowableBuffer(GrowableBuffer&, const u16, const VkDevice) noexcept(ND_ASSERT_NOTHROW);
+} // namespace nd::src::graphics::vulkan
@@ -0,0 +1,361 @@
+#include "host_allocator.hpp"
+#include "tools_runtime.hpp"
+
+namespace nd::src::graphics::vulkan
+{
+    using namespace nd::src::tools;
+
+    struct HostPoolPage final
+    {
+        u8 scope;
+        u8 classIndex;
+    };
+
+    struct HostPool final
+    {
+        vec<void*> chunks;
+    };
+
+    struct HostLarge final
+    {
+        u64 size;
+        u64 alignment;
+        u8  scope;
+    };
+
+    struct HostAllocator final
+    {
+        static constexpr u64 classMinLog = 4;
+        static constexpr u64 classMaxLog = 12;
+        static constexpr u64 classCount  = classMaxLog - classMinLog + 1;
+        static constexpr u64 pageSize    = 64 * 1024;
+        static constexpr u64 scopeCount  = VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE + 1;
+
+        std::mutex mutex;
+
+        array<array<HostPool, classCount>, scopeCount> pools;
+
+        std::unordered_map<u64, HostPoolPage> pages;
+        std::unordered_map<void*, HostLarge>  larges;
+
+        HostAllocationSnapshot snapshot;
+    };
+
+    HostAllocator&
+    getHostAllocator() noexcept
+    {
+        static auto hostAllocator = HostAllocator {};
+
+        return hostAllocator;
+    }
+
+    u64
+    getHostClassSize(const u8 classIndex) noexcept
+    {
+        return 1ULL << (classIndex + HostAllocator::classMinLog);
+    }
+
+    std::optional<u8>
+    getHostClassIndex(const u64 size, const u64 alignment) noexcept
+    {
+        const auto sizeLog = static_cast<u64>(std::bit_width(std::max({size, alignment, u64 {1} << HostAllocator::classMinLog}) - 1));
+
+        if(sizeLog > HostAllocator::classMaxLog)
+        {
+            return std::nullopt;
+        }
+
+        return static_cast<u8>(sizeLog - HostAllocator::classMinLog);
+    }
+
+    void
+    setHostAllocated(HostAllocationStats& stats, const u64 size) noexcept
+    {
+        stats.size += size;
+        stats.sizeMax = std::max(stats.sizeMax, stats.size);
+    }
+
+    void
+    setHostFreed(HostAllocationStats& stats, const u64 size) noexcept
+    {
+        stats.size -= size;
+    }
+
+    void*
+    allocateHostChunk(HostAllocator& allocator, const u8 scope, const u8 classIndex) noexcept
+    {
+        auto& pool = allocator.pools[scope][classIndex];
+
+        if(pool.chunks.empty())
+        {
+            auto* const page = static_cast<std::byte*>(std::aligned_alloc(HostAllocator::pageSize, HostAllocator::pageSize));
+
+            if(!page)
+            {
+                return nullptr;
+            }
+
+            const auto classSize = getHostClassSize(classIndex);
+
+            for(auto offset = HostAllocator::pageSize; offset; offset -= classSize)
+            {
+                pool.chunks.push_back(page + offset - classSize);
+            }
+
+            allocator.pages[reinterpret_cast<u64>(page)] = {.scope = scope, .classIndex = classIndex};
+        }
+
+        auto* const chunk = pool.chunks.back();
+
+        pool.chunks.pop_back();
+
+        return chunk;
+    }
+
+    void*
+    allocateHost(HostAllocator& allocator, const u64 size, const u64 alignment, const u8 scope) noexcept
+    {
+        const auto classIndex = getHostClassIndex(size, alignment);
+
+        if(classIndex.has_value())
+        {
+            auto* const chunk = allocateHostChunk(allocator, scope, classIndex.value());
+
+            if(chunk)
+            {
+                setHostAllocated(allocator.snapshot.scopes[scope], getHostClassSize(classIndex.value()));
+            }
+
+            return chunk;
+        }
+
+        const auto alignmentLarge = std::max(alignment, static_cast<u64>(alignof(std::max_align_t)));
+
+        auto* const large = std::aligned_alloc(alignmentLarge, (size + alignmentLarge - 1) / alignmentLarge * alignmentLarge);
+
+        if(large)
+        {
+            allocator.larges[large] = {.size = size, .alignment = alignmentLarge, .scope = scope};
+
+            setHostAllocated(allocator.snapshot.scopes[scope], size);
+        }
+
+        return large;
+    }
+
+    u64
+    getHostSize(const HostAllocator& allocator, void* const memory) noexcept
+    {
+        const auto page = allocator.pages.find(reinterpret_cast<u64>(memory) & ~(HostAllocator::pageSize - 1));
+
+        if(page != allocator.pages.end())
+        {
+            return getHostClassSize(page->second.classIndex);
+        }
+
+        const auto large = allocator.larges.find(memory);
+
+        return large != allocator.larges.end() ? large->second.size : 0;
+    }
+
+    bool
+    isHostOwned(const HostAllocator& allocator, void* const memory) noexcept
+    {
+        return allocator.pages.contains(reinterpret_cast<u64>(memory) & ~(HostAllocator::pageSize - 1)) || allocator.larges.contains(memory);
+    }
+
+    std::optional<u8>
+    freeHost(HostAllocator& allocator, void* const memory) noexcept
+    {
+        const auto page = allocator.pages.find(reinterpret_cast<u64>(memory) & ~(HostAllocator::pageSize - 1));
+
+        if(page != allocator.pages.end())
+        {
+            const auto [scope, classIndex] = page->second;
+
+            allocator.pools[scope][classIndex].chunks.push_back(memory);
+
+            setHostFreed(allocator.snapshot.scopes[scope], getHostClassSize(classIndex));
+
+            return scope;
+        }
+
+        const auto large = allocator.larges.find(memory);
+
+        if(large == allocator.larges.end())
+        {
+            return std::nullopt;
+        }
+
+        const auto scope = large->second.scope;
+
+        setHostFreed(allocator.snapshot.scopes[scope], large->second.size);
+
+        allocator.larges.erase(large);
+
+        std::free(memory);
+
+        return scope;
+    }
+
+    void* VKAPI_PTR
+    onHostAllocation(void* const userData, const size_t size, const size_t alignment, const VkSystemAllocationScope scope) noexcept
+    {
+        auto& allocator = *static_cast<HostAllocator*>(userData);
+
+        const auto lock = std::lock_guard {allocator.mutex};
+
+        auto* const memory = allocateHost(allocator, size, alignment, static_cast<u8>(scope));
+
+        if(memory)
+        {
+            allocator.snapshot.scopes[scope].allocationCount += 1;
+        }
+
+        return memory;
+    }
+
+    void* VKAPI_PTR
+    onHostReallocation(void* const                   userData,
+                       void* const                   original,
+                       const size_t                  size,
+                       const size_t                  alignment,
+                       const VkSystemAllocationScope scope) noexcept
+    {
+        auto& allocator = *static_cast<HostAllocator*>(userData);
+
+        const auto lock = std::lock_guard {allocator.mutex};
+
+        auto& stats = allocator.snapshot.scopes[scope];
+
+        if(!original)
+        {
+            auto* const memory = allocateHost(allocator, size, alignment, static_cast<u8>(scope));
+
+            stats.allocationCount += memory ? 1 : 0;
+
+            return memory;
+        }
+
+        if(!isHostOwned(allocator, original))
+        {
+            return nullptr;
+        }
+
+        if(!size)
+        {
+            allocator.snapshot.scopes[freeHost(allocator, original).value()].freeCount += 1;
+
+            return nullptr;
+        }
+
+        auto* const memory = allocateHost(allocator, size, alignment, static_cast<u8>(scope));
+
+        if(memory)
+        {
+            std::memcpy(memory, original, std::min(static_cast<u64>(size), getHostSize(allocator, original)));
+
+            freeHost(allocator, original);
+
+            stats.reallocationCount += 1;
+        }
+
+        return memory;
+    }
+
+    void VKAPI_PTR
+    onHostFree(void* const userData, void* const memory) noexcept
+    {
+        auto& allocator = *static_cast<HostAllocator*>(userData);
+
+        const auto lock = std::lock_guard {allocator.mutex};
+
+        if(!memory)
+        {
+            return;
+        }
+
+        if(const auto scope = freeHost(allocator, memory); scope.has_value())
+        {
+            allocator.snapshot.scopes[scope.value()].freeCount += 1;
+        }
+    }
+
+    void VKAPI_PTR
+    onHostInternalAllocation(void* const                    userData,
+                             const size_t                   size,
+                             const VkInternalAllocationType type,
+                             const VkSystemAllocationScope  scope) noexcept
+    {
+        auto& allocator = *static_cast<HostAllocator*>(userData);
+
+        const auto lock = std::lock_guard {allocator.mutex};
+
+        auto& stats = allocator.snapshot.scopes[scope];
+
+        stats.size += size;
+        stats.sizeMax = std::max(stats.sizeMax, stats.size);
+        stats.internalCount += 1;
+    }
+
+    void VKAPI_PTR
+    onHostInternalFree(void* const                    userData,
+                       const size_t                   size,
+                       const VkInternalAllocationType type,
+                       const VkSystemAllocationScope  scope) noexcept
+    {
+        auto& allocator = *static_cast<HostAllocator*>(userData);
+
+        const auto lock = std::lock_guard {allocator.mutex};
+
+        allocator.snapshot.scopes[scope].size -= size;
+    }
+
+    const VkAllocationCallbacks*
+    getHostAllocationCallbacks() noexcept
+    {
+        static const auto callbacks = VkAllocationCallbacks {.pUserData             = &getHostAllocator(),
+                                                             .pfnAllocation         = onHostAllocation,
+                                                             .pfnReallocation       = onHostReallocation,
+                                                             .pfnFree               = onHostFree,
+                                                             .pfnInternalAllocation = onHostInternalAllocation,
+                                                             .pfnInternalFree       = onHostInternalFree};
+
+        return &callbacks;
+    }
+
+    HostAllocationSnapshot
+    getHostAllocationSnapshot() noexcept
+    {
+        ND_SET_SCOPE();
+
+        auto& allocator = getHostAllocator();
+
+        const auto lock = std::lock_guard {allocator.mutex};
+
+        return allocator.snapshot;
+    }
+
+    HostAllocationSnapshot
+    getHostAllocationDelta(const HostAllocationSnapshot& snapshotFrom, const HostAllocationSnapshot& snapshotTo) noexcept
+    {
+        ND_SET_SCOPE();
+
+        auto delta = HostAllocationSnapshot {};
+
+        for(u64 index = 0; index < delta.scopes.size(); ++index)
+        {
+            const auto& from = snapshotFrom.scopes[index];
+            const auto& to   = snapshotTo.scopes[index];
+
+            delta.scopes[index] = {.size              = to.size,
+                                   .sizeMax           = to.sizeMax,
+                                   .allocationCount   = to.allocationCount - from.allocationCount,
+                                   .reallocationCount = to.reallocationCount - from.reallocationCount,
+                                   .freeCount         = to.freeCount - from.freeCount,
+                                   .internalCount     = to.internalCount - from.internalCount};
+        }
+
+        return delta;
+    }
+} // namespace nd::src::graphics::vulkan
@@ -0,0 +1,32 @@
+#pragma once
+
+#include "pch.hpp"
+#include "tools.hpp"
+
+namespace nd::src::graphics::vulkan
+{
+    struct HostAllocationStats final
+    {
+        u64 size;
+        u64 sizeMax;
+
+        u64 allocationCount;
+        u64 reallocationCount;
+        u64 freeCount;
+        u64 internalCount;
+    };
+
+    struct HostAllocationSnapshot final
+    {
+        array<HostAllocationStats, VK_SYSTEM_ALLOCATION_SCOPE_INSTANCE + 1> scopes;
+    };
+
+    const VkAllocationCallbacks*
+    getHostAllocationCallbacks() noexcept;
+
+    HostAllocationSnapshot
+    getHostAllocationSnapshot() noexcept;
+
+    HostAllocationSnapshot
+    getHostAllocationDelta(const HostAllocationSnapshot&, const HostAllocationSnapshot&) noexcept;
+} // namespace nd::src::graphics::vulkan
@@ -0,0 +1,459 @@
+#include "memory_allocator.hpp"
+#include "memory_init.hpp"
+#include "tools_runtime.hpp"
+
+namespace nd::src::graphics::vulkan
+{
+    using namespace nd::src::tools;
+
+    struct MemoryBlockIndex final
+    {
+        u8 fl;
+        u8 sl;
+    };
+
+    MemoryBlockIndex
+    getMemoryBlockIndex(const VkDeviceSize size) noexcept
+    {
+        using Type = MemoryAllocator;
+
+        if(size < Type::slCount)
+        {
+            return {.fl = 0, .sl = static_cast<u8>(size)};
+        }
+
+        const auto bit = static_cast<u8>(std::bit_width(size) - 1);
+
+        return {.fl = static_cast<u8>(bit - Type::slLog + 1), .sl = static_cast<u8>((size >> (bit - Type::slLog)) - Type::slCount)};
+    }
+
+    MemoryBlockIndex
+    getMemoryBlockIndexSearch(const VkDeviceSize size) noexcept
+    {
+        using Type = MemoryAllocator;
+
+        if(size < Type::slCount)
+        {
+            return getMemoryBlockIndex(size);
+        }
+
+        const auto bit = static_cast<u8>(std::bit_width(size) - 1);
+
+        return getMemoryBlockIndex(size + (1ULL << (bit - Type::slLog)) - 1);
+    }
+
+    bool
+    isMemoryBlockConflict(const MemoryBlockType type1, const MemoryBlockType type2) noexcept
+    {
+        return type1 != type2 && type1 != MemoryBlockType::free && type2 != MemoryBlockType::free;
+    }
+
+    u32
+    getMemoryBlockNew(MemoryAllocator& allocator, const MemoryBlock& block) noexcept
+    {
+        if(allocator.blocksUnused.empty())
+        {
+            allocator.blocks.push_back(block);
+
+            return static_cast<u32>(allocator.blocks.size() - 1);
+        }
+
+        const auto index = allocator.blocksUnused.back();
+
+        allocator.blocksUnused.pop_back();
+        allocator.blocks[index] = block;
+
+        return index;
+    }
+
+    void
+    setMemoryBlockUnused(MemoryAllocator& allocator, const u32 index) noexcept
+    {
+        allocator.blocks[index].type = MemoryBlockType::none;
+        allocator.blocksUnused.push_back(index);
+    }
+
+    void
+    insertMemoryBlockFree(MemoryAllocator& allocator, const u32 index) noexcept
+    {
+        auto& block = allocator.blocks[index];
+
+        const auto [fl, sl] = getMemoryBlockIndex(block.size);
+        const auto head     = allocator.freeHeads[fl][sl];
+
+        block.type     = MemoryBlockType::free;
+        block.freePrev = MemoryAllocator::blockNull;
+        block.freeNext = head;
+
+        if(head != MemoryAllocator::blockNull)
+        {
+            allocator.blocks[head].freePrev = index;
+        }
+
+        allocator.freeHeads[fl][sl] = index;
+        allocator.slBitmaps[fl] |= 1U << sl;
+        allocator.flBitmap |= 1ULL << fl;
+    }
+
+    void
+    removeMemoryBlockFree(MemoryAllocator& allocator, const u32 index) noexcept
+    {
+        const auto& block = allocator.blocks[index];
+
+        const auto [fl, sl] = getMemoryBlockIndex(block.size);
+
+        if(block.freePrev != MemoryAllocator::blockNull)
+        {
+            allocator.blocks[block.freePrev].freeNext = block.freeNext;
+        }
+        else
+        {
+            allocator.freeHeads[fl][sl] = block.freeNext;
+        }
+
+        if(block.freeNext != MemoryAllocator::blockNull)
+        {
+            allocator.blocks[block.freeNext].freePrev = block.freePrev;
+        }
+
+        if(allocator.freeHeads[fl][sl] == MemoryAllocator::blockNull)
+        {
+            allocator.slBitmaps[fl] &= ~(1U << sl);
+
+            if(!allocator.slBitmaps[fl])
+            {
+                allocator.flBitmap &= ~(1ULL << fl);
+            }
+        }
+    }
+
+    u32
+    getMemoryBlockFree(const MemoryAllocator& allocator, const VkDeviceSize size) noexcept
+    {
+        auto [fl, sl] = getMemoryBlockIndexSearch(size);
+
+        if(fl >= MemoryAllocator::flCount)
+        {
+            return MemoryAllocator::blockNull;
+        }
+
+        auto slBitmap = allocator.slBitmaps[fl] & (~0U << sl);
+
+        if(!slBitmap)
+        {
+            const auto flBitmap = fl + 1 < MemoryAllocator::flCount ? allocator.flBitmap & (~0ULL << (fl + 1)) : 0ULL;
+
+            if(!flBitmap)
+            {
+                return MemoryAllocator::blockNull;
+            }
+
+            fl       = static_cast<u8>(std::countr_zero(flBitmap));
+            slBitmap = allocator.slBitmaps[fl];
+        }
+
+        sl = static_cast<u8>(std::countr_zero(slBitmap));
+
+        return allocator.freeHeads[fl][sl];
+    }
+
+    std::optional<MemoryBlock>
+    getMemoryBlockPlacement(const MemoryAllocator&      allocator,
+                            const u32                   index,
+                            const VkMemoryRequirements& requirements,
+                            const MemoryBlockType       type,
+                            const VkDeviceSize          granularity) noexcept
+    {
+        const auto& block = allocator.blocks[index];
+
+        auto offset = getMemoryOffsetAligned(block.offset, requirements.alignment);
+
+        if(block.physicalPrev != MemoryAllocator::blockNull)
+        {
+            const auto& prev = allocator.blocks[block.physicalPrev];
+
+            if(isMemoryBlockConflict(prev.type, type) && (prev.offset + prev.size - 1) / granularity == offset / granularity)
+            {
+                offset = getMemoryOffsetAligned(offset, granularity);
+            }
+        }
+
+        auto end = offset + requirements.size;
+
+        if(block.physicalNext != MemoryAllocator::blockNull)
+        {
+            const auto& next = allocator.blocks[block.physicalNext];
+
+            if(isMemoryBlockConflict(next.type, type) && (end - 1) / granularity == next.offset / granularity)
+            {
+                end = getMemoryOffsetAligned(end, granularity);
+            }
+        }
+
+        if(end > block.offset + block.size)
+        {
+            return std::nullopt;
+        }
+
+        return MemoryBlock {.offset = offset, .size = end - offset, .type = type};
+    }
+
+    void
+    setMemoryBlockUsed(MemoryAllocator& allocator, const u32 index, const MemoryBlock& placement) noexcept
+    {
+        removeMemoryBlockFree(allocator, index);
+
+        const auto blockOffset = allocator.blocks[index].offset;
+        const auto blockEnd    = blockOffset + allocator.blocks[index].size;
+        const auto end         = placement.offset + placement.size;
+
+        if(placement.offset > blockOffset)
+        {
+            const auto front = getMemoryBlockNew(allocator,
+                                                 {.offset       = blockOffset,
+                                                  .size         = placement.offset - blockOffset,
+                                                  .physicalPrev = allocator.blocks[index].physicalPrev,
+                                                  .physicalNext = index});
+
+            if(allocator.blocks[front].physicalPrev != MemoryAllocator::blockNull)
+            {
+                allocator.blocks[allocator.blocks[front].physicalPrev].physicalNext = front;
+            }
+
+            allocator.blocks[index].physicalPrev = front;
+
+            insertMemoryBlockFree(allocator, front);
+        }
+
+        if(end < blockEnd)
+        {
+            const auto back = getMemoryBlockNew(allocator,
+                                                {.offset       = end,
+                                                 .size         = blockEnd - end,
+                                                 .physicalPrev = index,
+                                                 .physicalNext = allocator.blocks[index].physicalNext});
+
+            if(allocator.blocks[back].physicalNext != MemoryAllocator::blockNull)
+            {
+                allocator.blocks[allocator.blocks[back].physicalNext].physicalPrev = back;
+            }
+
+            allocator.blocks[index].physicalNext = back;
+
+            insertMemoryBlockFree(allocator, back);
+        }
+
+        auto& block = allocator.blocks[index];
+
+        block.offset = placement.offset;
+        block.size   = placement.size;
+        block.type   = placement.type;
+
+        allocator.blocksUsed[block.offset] = index;
+    }
+
+    void
+    setMemoryBlockMerged(MemoryAllocator& allocator, const u32 index, const u32 indexNext) noexcept
+    {
+        auto&       block     = allocator.blocks[index];
+        const auto& blockNext = allocator.blocks[indexNext];
+
+        block.size += blockNext.size;
+        block.physicalNext = blockNext.physicalNext;
+
+        if(block.physicalNext != MemoryAllocator::blockNull)
+        {
+            allocator.blocks[block.physicalNext].physicalPrev = index;
+        }
+
+        setMemoryBlockUnused(allocator, indexNext);
+    }
+
+    MemoryAllocator
+    getMemoryAllocator(const VkDeviceSize size) noexcept
+    {
+        ND_SET_SCOPE();
+
+        auto allocator = MemoryAllocator {.blocks       = {},
+                                          .blocksUnused = {},
+                                          .blocksUsed   = {},
+                                          .freeHeads    = {},
+                                          .slBitmaps    = {},
+                                          .flBitmap     = {},
+                                          .size         = size};
+
+        for(auto& freeHeads: allocator.freeHeads)
+        {
+            freeHeads.fill(MemoryAllocator::blockNull);
+        }
+
+        const auto index = getMemoryBlockNew(allocator,
+                                             {.offset       = 0,
+                                              .size         = size,
+                                              .physicalPrev = MemoryAllocator::blockNull,
+                                              .physicalNext = MemoryAllocator::blockNull});
+
+        insertMemoryBlockFree(allocator, index);
+
+        return allocator;
+    }
+
+    std::optional<VkDeviceSize>
+    allocateMemoryBlock(MemoryAllocator&            allocator,
+                        const VkMemoryRequirements& requirements,
+                        const MemoryBlockType       type,
+                        const VkDeviceSize          granularity) noexcept
+    {
+        ND_SET_SCOPE();
+
+        const auto paddings = array {requirements.alignment - 1, requirements.alignment - 1 + 2 * (granularity - 1)};
+
+        for(const auto padding: paddings)
+        {
+            const auto index = getMemoryBlockFree(allocator, requirements.size + padding);
+
+            if(index == MemoryAllocator::blockNull)
+            {
+                continue;
+            }
+
+            const auto placement = getMemoryBlockPlacement(allocator, index, requirements, type, granularity);
+
+            if(placement.has_value())
+            {
+                setMemoryBlockUsed(allocator, index, placement.value());
+
+                return placement.value().offset;
+            }
+        }
+
+        const auto [fl, sl] = getMemoryBlockIndex(requirements.size);
+
+        for(auto index = allocator.freeHeads[fl][sl]; index != MemoryAllocator::blockNull; index = allocator.blocks[index].freeNext)
+        {
+            const auto placement = getMemoryBlockPlacement(allocator, index, requirements, type, granularity);
+
+            if(placement.has_value())
+            {
+                setMemoryBlockUsed(allocator, index, placement.value());
+
+                return placement.value().offset;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    void
+    freeMemoryBlock(MemoryAllocator& allocator, const VkDeviceSize offset) noexcept(ND_ASSERT_NOTHROW)
+    {
+        ND_SET_SCOPE();
+
+        const auto used = allocator.blocksUsed.find(offset);
+
+        ND_ASSERT(used != allocator.blocksUsed.end());
+
+        const auto index = used->second;
+
+        allocator.blocksUsed.erase(used);
+        allocator.blocks[index].type = MemoryBlockType::free;
+
+        const auto prev = allocator.blocks[index].physicalPrev;
+        const auto next = allocator.blocks[index].physicalNext;
+
+        if(next != MemoryAllocator::blockNull && allocator.blocks[next].type == MemoryBlockType::free)
+        {
+            removeMemoryBlockFree(allocator, next);
+            setMemoryBlockMerged(allocator, index, next);
+        }
+
+        if(prev != MemoryAllocator::blockNull && allocator.blocks[prev].type == MemoryBlockType::free)
+        {
+            removeMemoryBlockFree(allocator, prev);
+            setMemoryBlockMerged(allocator, prev, index);
+            insertMemoryBlockFree(allocator, prev);
+
+            return;
+        }
+
+        insertMemoryBlockFree(allocator, index);
+    }
+
+    void
+    setMemoryAllocatorSize(MemoryAllocator& allocator, const VkDeviceSize size) noexcept(ND_ASSERT_NOTHROW)
+    {
+        ND_SET_SCOPE();
+
+        ND_ASSERT(size >= allocator.size);
+
+        const auto last = std::find_if(allocator.blocks.begin(),
+                                       allocator.blocks.end(),
+                                       [](const auto& block)
+                                       {
+                                           return block.type != MemoryBlockType::none && block.physicalNext == MemoryAllocator::blockNull;
+                                       });
+
+        ND_ASSERT(last != allocator.blocks.end());
+
+        const auto index = static_cast<u32>(last - allocator.blocks.begin());
+        const auto grown = size - allocator.size;
+
+        allocator.size = size;
+
+        if(!grown)
+        {
+            return;
+        }
+
+        if(allocator.blocks[index].type == MemoryBlockType::free)
+        {
+            removeMemoryBlockFree(allocator, index);
+
+            allocator.blocks[index].size += grown;
+
+            insertMemoryBlockFree(allocator, index);
+
+            return;
+        }
+
+        const auto next = getMemoryBlockNew(allocator,
+                                            {.offset       = size - grown,
+                                             .size         = grown,
+                                             .physicalPrev = index,
+                                             .physicalNext = MemoryAllocator::blockNull});
+
+        allocator.blocks[index].physicalNext = next;
+
+        insertMemoryBlockFree(allocator, next);
+    }
+
+    MemoryStats
+    getMemoryStats(const MemoryAllocator& allocator) noexcept
+    {
+        ND_SET_SCOPE();
+
+        auto stats = MemoryStats {.size = allocator.size};
+
+        for(const auto& block: allocator.blocks)
+        {
+            switch(block.type)
+            {
+                case MemoryBlockType::none:
+                    break;
+                case MemoryBlockType::free:
+                    stats.sizeFree += block.size;
+                    stats.sizeFreeMax = std::max(stats.sizeFreeMax, block.size);
+                    stats.freeBlockCount += 1;
+                    break;
+                default:
+                    stats.sizeUsed += block.size;
+                    stats.allocationCount += 1;
+                    break;
+            }
+        }
+
+        stats.fragmentation = stats.sizeFree ? 1.0f - static_cast<f32>(stats.sizeFreeMax) / stats.sizeFree : 0.0f;
+
+        return stats;
+    }
+} // namespace nd::src::graphics::vulkan
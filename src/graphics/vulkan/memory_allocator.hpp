@@ -0,0 +1,74 @@
+#pragma once
+
+#include "shared_init.hpp"
+
+namespace nd::src::graphics::vulkan
+{
+    enum class MemoryBlockType : u8
+    {
+        none,
+        free,
+        linear,
+        optimal
+    };
+
+    struct MemoryBlock final
+    {
+        VkDeviceSize offset;
+        VkDeviceSize size;
+
+        u32 physicalPrev;
+        u32 physicalNext;
+        u32 freePrev;
+        u32 freeNext;
+
+        MemoryBlockType type;
+    };
+
+    struct MemoryStats final
+    {
+        VkDeviceSize size;
+        VkDeviceSize sizeUsed;
+        VkDeviceSize sizeFree;
+        VkDeviceSize sizeFreeMax;
+
+        u32 allocationCount;
+        u32 freeBlockCount;
+
+        f32 fragmentation;
+    };
+
+    struct MemoryAllocator final
+    {
+        static constexpr u8  flCount   = 64;
+        static constexpr u8  slLog     = 5;
+        static constexpr u8  slCount   = 1 << slLog;
+        static constexpr u32 blockNull = std::numeric_limits<u32>::max();
+
+        vec<MemoryBlock> blocks;
+        vec<u32>         blocksUnused;
+
+        map<VkDeviceSize, u32> blocksUsed;
+
+        array<array<u32, slCount>, flCount> freeHeads;
+        array<u32, flCount>                 slBitmaps;
+        u64                                 flBitmap;
+
+        VkDeviceSize size;
+    };
+
+    MemoryAllocator
+    getMemoryAllocator(const VkDeviceSize) noexcept;
+
+    std::optional<VkDeviceSize>
+    allocateMemoryBlock(MemoryAllocator&, const VkMemoryRequirements&, const MemoryBlockType, const VkDeviceSize) noexcept;
+
+    void
+    freeMemoryBlock(MemoryAllocator&, const VkDeviceSize) noexcept(ND_ASSERT_NOTHROW);
+
+    void
+    setMemoryAllocatorSize(MemoryAllocator&, const VkDeviceSize) noexcept(ND_ASSERT_NOTHROW);
+
+    MemoryStats
+    getMemoryStats(const MemoryAllocator&) noexcept;
+} // namespace nd::src::graphics::vulkan
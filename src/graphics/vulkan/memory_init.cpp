@@ -1,39 +1,39 @@
 #include "memory_init.hpp"
+#include "device_init.hpp"
 #include "tools_runtime.hpp"
 
 namespace nd::src::graphics::vulkan
 {
     using namespace nd::src::tools;
 
-    struct MemoryState final
+    map<VkDeviceMemory, MemoryAllocator>&
+    getMemoryAllocators() noexcept
     {
-        vec<VkDeviceSize> offsets;
-        vec<VkDeviceSize> size;
-    };
+        ND_SET_SCOPE();
+
+        static auto memoryAllocators = map<VkDeviceMemory, MemoryAllocator> {};
 
-    MemoryState&
-    getMemoryState(const VkPhysicalDevice physicalDevice) noexcept
+        return memoryAllocators;
+    }
+
+    array<VkDeviceSize, VK_MAX_MEMORY_HEAPS>&
+    getMemoryHeapUsage() noexcept
     {
         ND_SET_SCOPE();
 
-        static auto memoryStates = map<VkPhysicalDevice, MemoryState> {};
-
-        if(memoryStates.find(physicalDevice) == memoryStates.end())
-        {
-            const auto memoryProperties = getMemoryProperties(physicalDevice);
+        static auto memoryHeapUsage = array<VkDeviceSize, VK_MAX_MEMORY_HEAPS> {};
 
-            auto memoryState = MemoryState {.offsets = vec<VkDeviceSize>(memoryProperties.memoryHeapCount, 0ULL),
-                                            .size    = vec<VkDeviceSize>(memoryProperties.memoryHeapCount)};
+        return memoryHeapUsage;
+    }
 
-            for(u8 index = 0; index < memoryProperties.memoryHeapCount; ++index)
-            {
-                memoryState.size[index] = memoryProperties.memoryHeaps[index].size;
-            }
+    MemoryBudget&
+    getMemoryBudgetLatest() noexcept
+    {
+        ND_SET_SCOPE();
 
-            memoryStates[physicalDevice] = std::move(memoryState);
-        }
+        static auto memoryBudget = MemoryBudget {};
 
-        return memoryStates[physicalDevice];
+        return memoryBudget;
     }
 
     VkPhysicalDeviceMemoryProperties
@@ -72,18 +72,130 @@ namespace nd::src::graphics::vulkan
         return requirements;
     }
 
+    bool
+    isBufferMemoryDedicated(const VkBuffer buffer, const VkDevice device) noexcept
+    {
+        ND_SET_SCOPE();
+
+        const auto info = VkBufferMemoryRequirementsInfo2 {.sType  = VK_STRUCTURE_TYPE_BUFFER_MEMORY_REQUIREMENTS_INFO_2,
+                                                           .pNext  = {},
+                                                           .buffer = buffer};
+
+        auto dedicatedRequirements = VkMemoryDedicatedRequirements {.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS};
+        auto requirements          = VkMemoryRequirements2 {.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2, .pNext = &dedicatedRequirements};
+
+        vkGetBufferMemoryRequirements2(device, &info, &requirements);
+
+        return dedicatedRequirements.prefersDedicatedAllocation || dedicatedRequirements.requiresDedicatedAllocation;
+    }
+
+    bool
+    isImageMemoryDedicated(const VkImage image, const VkDevice device) noexcept
+    {
+        ND_SET_SCOPE();
+
+        const auto info = VkImageMemoryRequirementsInfo2 {.sType = VK_STRUCTURE_TYPE_IMAGE_MEMORY_REQUIREMENTS_INFO_2, .pNext = {}, .image = image};
+
+        auto dedicatedRequirements = VkMemoryDedicatedRequirements {.sType = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_REQUIREMENTS};
+        auto requirements          = VkMemoryRequirements2 {.sType = VK_STRUCTURE_TYPE_MEMORY_REQUIREMENTS_2, .pNext = &dedicatedRequirements};
+
+        vkGetImageMemoryRequirements2(device, &info, &requirements);
+
+        return dedicatedRequirements.prefersDedicatedAllocation || dedicatedRequirements.requiresDedicatedAllocation;
+    }
+
+    VkDeviceSize
+    getMemoryGranularity(const VkPhysicalDevice physicalDevice) noexcept
+    {
+        ND_SET_SCOPE();
+
+        static auto memoryGranularities = map<VkPhysicalDevice, VkDeviceSize> {};
+
+        const auto memoryGranularity = memoryGranularities.find(physicalDevice);
+
+        if(memoryGranularity != memoryGranularities.end())
+        {
+            return memoryGranularity->second;
+        }
+
+        return memoryGranularities[physicalDevice] = getPhysicalDeviceProperties(physicalDevice).limits.bufferImageGranularity;
+    }
+
+    MemoryBudget
+    getMemoryBudget(const VkPhysicalDevice physicalDevice, const vec<str>& extensions) noexcept
+    {
+        ND_SET_SCOPE();
+
+        auto budgetProperties = VkPhysicalDeviceMemoryBudgetPropertiesEXT {.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_BUDGET_PROPERTIES_EXT};
+        auto properties       = VkPhysicalDeviceMemoryProperties2 {.sType = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_MEMORY_PROPERTIES_2};
+
+        const auto isBudgetSupported = std::find(extensions.begin(), extensions.end(), "VK_EXT_memory_budget") != extensions.end();
+
+        if(isBudgetSupported)
+        {
+            properties.pNext = &budgetProperties;
+        }
+
+        vkGetPhysicalDeviceMemoryProperties2(physicalDevice, &properties);
+
+        const auto& memoryHeaps     = properties.memoryProperties.memoryHeaps;
+        const auto  memoryHeapCount = properties.memoryProperties.memoryHeapCount;
+
+        if(isBudgetSupported)
+        {
+            return getMemoryBudgetLatest() = {.budget    = std::to_array(budgetProperties.heapBudget),
+                                              .usage     = std::to_array(budgetProperties.heapUsage),
+                                              .heapCount = memoryHeapCount};
+        }
+
+        auto budget = MemoryBudget {.budget = {}, .usage = getMemoryHeapUsage(), .heapCount = memoryHeapCount};
+
+        for(u32 index = 0; index < memoryHeapCount; ++index)
+        {
+            budget.budget[index] = memoryHeaps[index].size / 10 * 8;
+        }
+
+        return getMemoryBudgetLatest() = budget;
+    }
+
+    bool
+    isMemoryBudgetAvailable(const MemoryBudget& budget, const u32 heapIndex, const VkDeviceSize size) noexcept
+    {
+        ND_SET_SCOPE();
+
+        return budget.usage[heapIndex] + size <= budget.budget[heapIndex];
+    }
+
+    bool
+    isMemoryTypeMatching(const VkMemoryType memoryType, const VkMemoryPropertyFlags flags, const VkMemoryPropertyFlags flagsNot) noexcept
+    {
+        return isContainsAll(memoryType.propertyFlags, flags) && !isContainsAny(memoryType.propertyFlags, flagsNot);
+    }
+
     u8
-    getMemoryTypeIndex(opt<const DeviceMemoryCfg>::ref cfg, const VkPhysicalDeviceMemoryProperties& memoryProperties) noexcept(ND_ASSERT_NOTHROW)
+    getMemoryTypeIndex(opt<const DeviceMemoryCfg>::ref         cfg,
+                       const VkPhysicalDeviceMemoryProperties& memoryProperties,
+                       const MemoryBudget&                     memoryBudget) noexcept(ND_ASSERT_NOTHROW)
     {
         ND_SET_SCOPE();
 
         for(u8 index = 0; index < memoryProperties.memoryTypeCount; ++index)
         {
             const auto memoryType = memoryProperties.memoryTypes[index];
-            const auto memoryHeap = memoryProperties.memoryHeaps[memoryType.heapIndex];
 
-            if(isContainsAll(memoryType.propertyFlags, cfg.propertyFlags) && !isContainsAny(memoryType.propertyFlags, cfg.propertyFlagsNot) &&
-               memoryHeap.size > cfg.size)
+            if(isMemoryTypeMatching(memoryType, cfg.propertyFlags, cfg.propertyFlagsNot) &&
+               isMemoryBudgetAvailable(memoryBudget, memoryType.heapIndex, cfg.size))
+            {
+                return index;
+            }
+        }
+
+        for(u8 index = 0; index < memoryProperties.memoryTypeCount; ++index)
+        {
+            const auto memoryType = memoryProperties.memoryTypes[index];
+
+            if(isMemoryTypeMatching(memoryType, cfg.propertyFlagsFallback, cfg.propertyFlagsNot) &&
+               isMemoryBudgetAvailable(memoryBudget, memoryType.heapIndex, cfg.size))
             {
                 return index;
             }
@@ -109,29 +221,61 @@ namespace nd::src::graphics::vulkan
         return offset + alignment - mod;
     }
 
+    std::optional<VkDeviceSize>
+    allocateMemoryOffset(opt<const DeviceMemory>::ref memory,
+                         const VkMemoryRequirements&  requirements,
+                         const MemoryBlockType        type,
+                         const VkPhysicalDevice       physicalDevice) noexcept
+    {
+        ND_SET_SCOPE();
+
+        if(!isContainsAny(requirements.memoryTypeBits, 1 << memory.typeIndex))
+        {
+            return std::nullopt;
+        }
+
+        return allocateMemoryBlock(getMemoryAllocators().at(memory.handle), requirements, type, getMemoryGranularity(physicalDevice));
+    }
+
     VkDeviceSize
     getMemoryOffset(opt<const DeviceMemory>::ref memory,
                     const VkMemoryRequirements&  requirements,
+                    const MemoryBlockType        type,
                     const VkPhysicalDevice       physicalDevice) noexcept(ND_ASSERT_NOTHROW)
     {
         ND_SET_SCOPE();
 
-        const auto& memoryState = getMemoryState(physicalDevice);
-
         ND_ASSERT(isContainsAny(requirements.memoryTypeBits, 1 << memory.typeIndex));
-        ND_ASSERT(requirements.size <= memoryState.size[memory.heapIndex] - memoryState.offsets[memory.heapIndex]);
 
-        return getMemoryOffsetAligned(memoryState.offsets[memory.heapIndex], requirements.alignment);
+        const auto offset = allocateMemoryOffset(memory, requirements, type, physicalDevice);
+
+        ND_ASSERT(offset.has_value());
+
+        return offset.value();
+    }
+
+    MemoryStats
+    getMemoryStats(opt<const DeviceMemory>::ref memory) noexcept(ND_ASSERT_NOTHROW)
+    {
+        ND_SET_SCOPE();
+
+        const auto& memoryAllocators = getMemoryAllocators();
+        const auto  memoryAllocator  = memoryAllocators.find(memory.handle);
+
+        ND_ASSERT(memoryAllocator != memoryAllocators.end());
+
+        return getMemoryStats(memoryAllocator->second);
     }
 
     DeviceMemory
     allocateMemory(opt<const DeviceMemoryCfg>::ref         cfg,
                    const VkPhysicalDeviceMemoryProperties& memoryProperties,
-                   const VkDevice                          device) noexcept(ND_VK_ASSERT_NOTHROW)
+                   MemoryBudget&                           memoryBudget,
+                   const VkDevice                          device) noexcept(ND_VK_ASSERT_NOTHROW&& ND_ASSERT_NOTHROW)
     {
         ND_SET_SCOPE();
 
-        const auto memoryTypeIndex = getMemoryTypeIndex(cfg, memoryProperties);
+        const auto memoryTypeIndex = getMemoryTypeIndex(cfg, memoryProperties, memoryBudget);
         const auto memoryHeapIndex = static_cast<u8>(memoryProperties.memoryTypes[memoryTypeIndex].heapIndex);
 
         const auto allocateInfo = VkMemoryAllocateInfo {.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
@@ -143,10 +287,92 @@ namespace nd::src::graphics::vulkan
 
         ND_VK_ASSERT(vkAllocateMemory(device, &allocateInfo, ND_VK_ALLOCATION_CALLBACKS, &deviceMemory));
 
-        return {.handle = deviceMemory, .typeIndex = memoryTypeIndex, .heapIndex = memoryHeapIndex};
+        void* data = nullptr;
+
+        if(isContainsAll(memoryProperties.memoryTypes[memoryTypeIndex].propertyFlags,
+                         VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT))
+        {
+            ND_VK_ASSERT(vkMapMemory(device, deviceMemory, 0, VK_WHOLE_SIZE, {}, &data));
+        }
+
+        getMemoryAllocators()[deviceMemory] = getMemoryAllocator(cfg.size);
+        getMemoryHeapUsage()[memoryHeapIndex] += cfg.size;
+        getMemoryBudgetLatest().usage[memoryHeapIndex] += cfg.size;
+
+        memoryBudget.usage[memoryHeapIndex] += cfg.size;
+
+        return {.handle        = deviceMemory,
+                .data          = data,
+                .dedicatedSize = cfg.dedicatedSize,
+                .typeIndex     = memoryTypeIndex,
+                .heapIndex     = memoryHeapIndex,
+                .dedicated     = false};
     }
 
-    VkDeviceSize
+    std::optional<DeviceMemory>
+    allocateMemoryDedicated(opt<const DeviceMemory>::ref         memory,
+                            const VkMemoryRequirements&          requirements,
+                            const VkMemoryDedicatedAllocateInfo& dedicatedInfo,
+                            const VkDevice                       device) noexcept(ND_VK_ASSERT_NOTHROW&& ND_ASSERT_NOTHROW)
+    {
+        ND_SET_SCOPE();
+
+        ND_ASSERT(isContainsAny(requirements.memoryTypeBits, 1 << memory.typeIndex));
+
+        if(!isMemoryBudgetAvailable(getMemoryBudgetLatest(), memory.heapIndex, requirements.size))
+        {
+            return std::nullopt;
+        }
+
+        const auto allocateInfo = VkMemoryAllocateInfo {.sType           = VK_STRUCTURE_TYPE_MEMORY_ALLOCATE_INFO,
+                                                        .pNext           = &dedicatedInfo,
+                                                        .allocationSize  = requirements.size,
+                                                        .memoryTypeIndex = memory.typeIndex};
+
+        VkDeviceMemory deviceMemory;
+
+        if(vkAllocateMemory(device, &allocateInfo, ND_VK_ALLOCATION_CALLBACKS, &deviceMemory) != VK_SUCCESS)
+        {
+            return std::nullopt;
+        }
+
+        void* data = nullptr;
+
+        if(memory.data)
+        {
+            ND_VK_ASSERT(vkMapMemory(device, deviceMemory, 0, VK_WHOLE_SIZE, {}, &data));
+        }
+
+        getMemoryAllocators()[deviceMemory] = getMemoryAllocator(requirements.size);
+        getMemoryHeapUsage()[memory.heapIndex] += requirements.size;
+        getMemoryBudgetLatest().usage[memory.heapIndex] += requirements.size;
+
+        return DeviceMemory {.handle        = deviceMemory,
+                             .data          = data,
+                             .dedicatedSize = memory.dedicatedSize,
+                             .typeIndex     = memory.typeIndex,
+                             .heapIndex     = memory.heapIndex,
+                             .dedicated     = true};
+    }
+
+    void
+    freeMemory(opt<const DeviceMemory>::ref memory, const VkDevice device) noexcept
+    {
+        ND_SET_SCOPE();
+
+        auto& memoryAllocators = getMemoryAllocators();
+
+        const auto size = memoryAllocators.at(memory.handle).size;
+        auto&      usage = getMemoryBudgetLatest().usage[memory.heapIndex];
+
+        getMemoryHeapUsage()[memory.heapIndex] -= size;
+        usage -= std::min(usage, size);
+        memoryAllocators.erase(memory.handle);
+
+        vkFreeMemory(device, memory.handle, ND_VK_ALLOCATION_CALLBACKS);
+    }
+
+    MemoryBinding
     bindBufferMemory(const VkBuffer               buffer,
                      opt<const DeviceMemory>::ref memory,
                      const VkDevice               device,
@@ -155,14 +381,26 @@ namespace nd::src::graphics::vulkan
         ND_SET_SCOPE();
 
         const auto requirements = getBufferMemoryRequirements(buffer, device);
-        const auto offset       = getMemoryOffset(memory, requirements, physicalDevice);
 
-        ND_VK_ASSERT(vkBindBufferMemory(device, buffer, memory.handle, offset));
+        const auto dedicatedInfo = VkMemoryDedicatedAllocateInfo {.sType  = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO,
+                                                                  .pNext  = {},
+                                                                  .image  = {},
+                                                                  .buffer = buffer};
+
+        const auto dedicated = requirements.size > memory.dedicatedSize || isBufferMemoryDedicated(buffer, device)
+                                   ? allocateMemoryDedicated(memory, requirements, dedicatedInfo, device)
+                                   : std::nullopt;
+
+        const auto binding = dedicated.value_or(memory);
+
+        const auto offset = getMemoryOffset(binding, requirements, MemoryBlockType::linear, physicalDevice);
+
+        ND_VK_ASSERT(vkBindBufferMemory(device, buffer, binding.handle, offset));
 
-        return getMemoryState(physicalDevice).offsets[memory.heapIndex] = offset;
+        return {.memory = binding, .offset = offset};
     }
 
-    VkDeviceSize
+    MemoryBinding
     bindImageMemory(const VkImage                image,
                     opt<const DeviceMemory>::ref memory,
                     const VkDevice               device,
@@ -171,10 +409,35 @@ namespace nd::src::graphics::vulkan
         ND_SET_SCOPE();
 
         const auto requirements = getImageMemoryRequirements(image, device);
-        const auto offset       = getMemoryOffset(memory, requirements, physicalDevice);
 
-        ND_VK_ASSERT(vkBindImageMemory(device, image, memory.handle, offset));
+        const auto dedicatedInfo = VkMemoryDedicatedAllocateInfo {.sType  = VK_STRUCTURE_TYPE_MEMORY_DEDICATED_ALLOCATE_INFO,
+                                                                  .pNext  = {},
+                                                                  .image  = image,
+                                                                  .buffer = {}};
+
+        const auto dedicated = requirements.size > memory.dedicatedSize || isImageMemoryDedicated(image, device)
+                                   ? allocateMemoryDedicated(memory, requirements, dedicatedInfo, device)
+                                   : std::nullopt;
+
+        const auto binding = dedicated.value_or(memory);
+
+        const auto offset = getMemoryOffset(binding, requirements, MemoryBlockType::optimal, physicalDevice);
 
-        return getMemoryState(physicalDevice).offsets[memory.heapIndex] = offset;
+        ND_VK_ASSERT(vkBindImageMemory(device, image, binding.handle, offset));
+
+        return {.memory = binding, .offset = offset};
+    }
+
+    void
+    unbindMemory(opt<const DeviceMemory>::ref memory, const VkDeviceSize offset, const VkDevice device) noexcept(ND_ASSERT_NOTHROW)
+    {
+        ND_SET_SCOPE();
+
+        freeMemoryBlock(getMemoryAllocators().at(memory.handle), offset);
+
+        if(memory.dedicated)
+        {
+            freeMemory(memory, device);
+        }
     }
 } // namespace nd::src::graphics::vulkan
@@ -2,8 +2,24 @@
 
 #include "shared_init.hpp"
 
+#include "memory_allocator.hpp"
+
 namespace nd::src::graphics::vulkan
 {
+    struct MemoryBudget final
+    {
+        array<VkDeviceSize, VK_MAX_MEMORY_HEAPS> budget;
+        array<VkDeviceSize, VK_MAX_MEMORY_HEAPS> usage;
+
+        u32 heapCount;
+    };
+
+    struct MemoryBinding final
+    {
+        DeviceMemory memory;
+        VkDeviceSize offset;
+    };
+
     VkPhysicalDeviceMemoryProperties
     getMemoryProperties(const VkPhysicalDevice) noexcept;
 
@@ -13,23 +29,60 @@ namespace nd::src::graphics::vulkan
     VkMemoryRequirements
     getImageMemoryRequirements(const VkImage, const VkDevice) noexcept;
 
+    bool
+    isBufferMemoryDedicated(const VkBuffer, const VkDevice) noexcept;
+
+    bool
+    isImageMemoryDedicated(const VkImage, const VkDevice) noexcept;
+
+    VkDeviceSize
+    getMemoryGranularity(const VkPhysicalDevice) noexcept;
+
+    MemoryBudget
+    getMemoryBudget(const VkPhysicalDevice, const vec<str>&) noexcept;
+
+    bool
+    isMemoryBudgetAvailable(const MemoryBudget&, const u32, const VkDeviceSize) noexcept;
+
     u8
-    getMemoryTypeIndex(opt<const DeviceMemoryCfg>::ref, const VkPhysicalDeviceMemoryProperties&) noexcept(ND_ASSERT_NOTHROW);
+    getMemoryTypeIndex(opt<const DeviceMemoryCfg>::ref, const VkPhysicalDeviceMemoryProperties&, const MemoryBudget&) noexcept(ND_ASSERT_NOTHROW);
 
     VkDeviceSize
     getMemoryOffsetAligned(const VkDeviceSize, const VkDeviceSize) noexcept;
 
+    std::optional<VkDeviceSize>
+    allocateMemoryOffset(opt<const DeviceMemory>::ref, const VkMemoryRequirements&, const MemoryBlockType, const VkPhysicalDevice) noexcept;
+
     VkDeviceSize
     getMemoryOffset(opt<const DeviceMemory>::ref memory,
                     const VkMemoryRequirements&  requirements,
+                    const MemoryBlockType        type,
                     const VkPhysicalDevice       physicalDevice) noexcept(ND_ASSERT_NOTHROW);
 
+    MemoryStats
+    getMemoryStats(opt<const DeviceMemory>::ref) noexcept(ND_ASSERT_NOTHROW);
+
     DeviceMemory
-    allocateMemory(opt<const DeviceMemoryCfg>::ref, const VkPhysicalDeviceMemoryProperties&, const VkDevice) noexcept(ND_VK_ASSERT_NOTHROW);
+    allocateMemory(opt<const DeviceMemoryCfg>::ref,
+                   const VkPhysicalDeviceMemoryProperties&,
+                   MemoryBudget&,
+                   const VkDevice) noexcept(ND_VK_ASSERT_NOTHROW&& ND_ASSERT_NOTHROW);
 
-    VkDeviceSize
+    std::optional<DeviceMemory>
+    allocateMemoryDedicated(opt<const DeviceMemory>::ref,
+                            const VkMemoryRequirements&,
+                            const VkMemoryDedicatedAllocateInfo&,
+                            const VkDevice) noexcept(ND_VK_ASSERT_NOTHROW&& ND_ASSERT_NOTHROW);
+
+    void
+    freeMemory(opt<const DeviceMemory>::ref, const VkDevice) noexcept;
+
+    MemoryBinding
     bindBufferMemory(const VkBuffer, opt<const DeviceMemory>::ref, const VkDevice, const VkPhysicalDevice) noexcept(ND_VK_ASSERT_NOTHROW);
 
-    VkDeviceSize
+    MemoryBinding
     bindImageMemory(const VkImage, opt<const DeviceMemory>::ref, const VkDevice, const VkPhysicalDevice) noexcept(ND_VK_ASSERT_NOTHROW);
+
+    void
+    unbindMemory(opt<const DeviceMemory>::ref, const VkDeviceSize, const VkDevice) noexcept(ND_ASSERT_NOTHROW);
 } // namespace nd::src::graphics::vulkan
@@ -33,9 +33,12 @@ namespace nd::src::graphics::vulkan
     struct DeviceMemory final
     {
         VkDeviceMemory handle;
+        void*          data;
+        VkDeviceSize   dedicatedSize;
 
-        u8 typeIndex;
-        u8 heapIndex;
+        u8   typeIndex;
+        u8   heapIndex;
+        bool dedicated;
     };
 
     struct QueueFamily final
@@ -49,6 +52,7 @@ namespace nd::src::graphics::vulkan
     {
         DeviceMemory device;
         DeviceMemory host;
+        DeviceMemory mapped;
     };
 
     struct QueueFamilyObjects final
@@ -56,6 +60,9 @@ namespace nd::src::graphics::vulkan
         QueueFamily graphics;
         QueueFamily transfer;
         QueueFamily compute;
+
+        vec<u32> graphicsCompute;
+        vec<u32> transferGraphicsCompute;
     };
 
     struct Device final
@@ -63,6 +70,8 @@ namespace nd::src::graphics::vulkan
         DeviceMemoryObjects memory;
         QueueFamilyObjects  queueFamily;
 
+        vec<str> extensions;
+
         VkDevice handle;
     };
 
@@ -82,15 +91,23 @@ namespace nd::src::graphics::vulkan
 
     struct Buffer final
     {
+        DeviceMemory memory;
         VkDeviceSize offset;
+        VkDeviceSize size;
 
-        VkBuffer handle;
+        VkBufferUsageFlags usage;
+        VkBuffer           handle;
+
+        span<const u32> queueFamilyIndices;
     };
 
     struct BufferObjects final
     {
         Buffer mesh;
-        Buffer stage;
+        Buffer transient;
+        Buffer cull;
+        Buffer draw;
+        Buffer stream;
     };
 
     // --------------- E ---------------
@@ -134,6 +151,8 @@ namespace nd::src::graphics::vulkan
     struct DescriptorSetLayoutObjects final
     {
         DescriptorSetLayout mesh;
+        DescriptorSetLayout meshlet;
+        DescriptorSetLayout draw;
     };
 
     // ----------------- E -----------------
@@ -160,11 +179,15 @@ namespace nd::src::graphics::vulkan
     struct PipelineLayoutObjects final
     {
         PipelineLayout mesh;
+        PipelineLayout meshlet;
+        PipelineLayout draw;
     };
 
     struct PipelineObjects final
     {
         Pipeline mesh;
+        Pipeline meshlet;
+        Pipeline draw;
     };
 
     // ---------------- E ----------------
@@ -186,6 +209,7 @@ namespace nd::src::graphics::vulkan
         vec<CommandPool> graphics;
         vec<CommandPool> transfer;
         vec<CommandPool> compute;
+        vec<CommandPool> stream;
     };
 
     // --------------- EE ---------------
@@ -221,5 +245,7 @@ namespace nd::src::graphics::vulkan
         RenderPass     renderPass;
         DescriptorPool descriptorPool;
         PipelineCache  pipelineCache;
+
+        u16 frameCount;
     };
 } // namespace nd::src::graphics::vulkan
@@ -41,7 +41,11 @@ namespace nd::src::graphics::vulkan
     {
         ND_SET_SCOPE();
 
-        return {.features = {},
+        return {.features           = {.multiDrawIndirect = VK_TRUE},
+                .features12         = {.sType             = VK_STRUCTURE_TYPE_PHYSICAL_DEVICE_VULKAN_1_2_FEATURES,
+                                       .drawIndirectCount = VK_TRUE,
+                                       .timelineSemaphore = VK_TRUE},
+                .subgroupOperations = VK_SUBGROUP_FEATURE_BASIC_BIT | VK_SUBGROUP_FEATURE_BALLOT_BIT,
                 .priority =
                     [](const auto features, const auto properties)
                 {
@@ -56,18 +60,33 @@ namespace nd::src::graphics::vulkan
     {
         ND_SET_SCOPE();
 
-        return {.features    = physicalDeviceCfg.features,
-                .memory      = {.device = {.size             = 8 * 1024,
-                                           .propertyFlags    = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
-                                           .propertyFlagsNot = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT},
-                                .host   = {.size             = 8 * 1024,
-                                           .propertyFlags    = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
-                                           .propertyFlagsNot = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT}},
-                .queueFamily = {.graphics = {.queueFlags = VK_QUEUE_GRAPHICS_BIT, .queueFlagsNot = {}},
-                                .transfer = {.queueFlags = VK_QUEUE_TRANSFER_BIT, .queueFlagsNot = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT},
-                                .compute  = {.queueFlags = VK_QUEUE_COMPUTE_BIT, .queueFlagsNot = VK_QUEUE_GRAPHICS_BIT}},
-                .extensions  = physicalDeviceCfg.extensions,
-                .queueFlags  = physicalDeviceCfg.queueFlags};
+        return {.features           = physicalDeviceCfg.features,
+                .features12         = physicalDeviceCfg.features12,
+                .memory             = {.device = {.size                  = 64 * 1024 * 1024,
+                                                  .propertyFlags         = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                                  .propertyFlagsNot      = {},
+                                                  .propertyFlagsFallback = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT,
+                                                  .dedicatedSize         = 4 * 1024 * 1024},
+                                       .host   = {.size                  = 32 * 1024 * 1024,
+                                                  .propertyFlags         = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT | VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                                  .propertyFlagsNot      = {},
+                                                  .propertyFlagsFallback = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                                                                           VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                                  .dedicatedSize         = 16 * 1024 * 1024},
+                                       .mapped = {.size                  = 32 * 1024 * 1024,
+                                                  .propertyFlags         = VK_MEMORY_PROPERTY_DEVICE_LOCAL_BIT | VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                                                                           VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                                  .propertyFlagsNot      = {},
+                                                  .propertyFlagsFallback = VK_MEMORY_PROPERTY_HOST_VISIBLE_BIT |
+                                                                           VK_MEMORY_PROPERTY_HOST_COHERENT_BIT,
+                                                  .dedicatedSize         = 16 * 1024 * 1024}},
+                .queueFamily        = {.graphics = {.queueFlags = VK_QUEUE_GRAPHICS_BIT, .queueFlagsNot = {}},
+                                       .transfer = {.queueFlags    = VK_QUEUE_TRANSFER_BIT,
+                                                    .queueFlagsNot = VK_QUEUE_GRAPHICS_BIT | VK_QUEUE_COMPUTE_BIT},
+                                       .compute  = {.queueFlags = VK_QUEUE_COMPUTE_BIT, .queueFlagsNot = VK_QUEUE_GRAPHICS_BIT}},
+                .extensions         = physicalDeviceCfg.extensions,
+                .extensionsOptional = {"VK_EXT_memory_budget"},
+                .queueFlags         = physicalDeviceCfg.queueFlags};
     }
 
     BufferObjectsCfg
@@ -75,17 +94,35 @@ namespace nd::src::graphics::vulkan
     {
         ND_SET_SCOPE();
 
-        return {.mesh  = {.queueFamilyIndices = {},
-                          .memory             = device.memory.device,
-                          .size               = 8 * 1024,
-                          .usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT |
-                             VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT,
-                          .sharingMode = VK_SHARING_MODE_EXCLUSIVE},
-                .stage = {.queueFamilyIndices = {},
-                          .memory             = device.memory.host,
-                          .size               = 8 * 1024,
-                          .usage              = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
-                          .sharingMode        = VK_SHARING_MODE_EXCLUSIVE}};
+        return {.mesh      = {.queueFamilyIndices = device.queueFamily.transferGraphicsCompute,
+                              .memory             = device.memory.device,
+                              .size               = 8 * 1024,
+                              .usage = VK_BUFFER_USAGE_TRANSFER_SRC_BIT | VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT |
+                                 VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                              .sharingMode = VK_SHARING_MODE_CONCURRENT},
+                .transient = {.queueFamilyIndices = device.queueFamily.graphicsCompute,
+                              .memory             = device.memory.mapped,
+                              .size               = 16 * 1024 * 1024,
+                              .usage = VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_UNIFORM_BUFFER_BIT |
+                                 VK_BUFFER_USAGE_STORAGE_BUFFER_BIT,
+                              .sharingMode = VK_SHARING_MODE_CONCURRENT},
+                .cull      = {.queueFamilyIndices = device.queueFamily.graphicsCompute,
+                              .memory             = device.memory.device,
+                              .size               = 16 * 1024 * 1024,
+                              .usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_INDEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                                 VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+                              .sharingMode = VK_SHARING_MODE_CONCURRENT},
+                .draw      = {.queueFamilyIndices = device.queueFamily.graphicsCompute,
+                              .memory             = device.memory.device,
+                              .size               = 16 * 1024 * 1024,
+                              .usage = VK_BUFFER_USAGE_TRANSFER_DST_BIT | VK_BUFFER_USAGE_VERTEX_BUFFER_BIT | VK_BUFFER_USAGE_STORAGE_BUFFER_BIT |
+                                 VK_BUFFER_USAGE_INDIRECT_BUFFER_BIT,
+                              .sharingMode = VK_SHARING_MODE_CONCURRENT},
+                .stream    = {.queueFamilyIndices = {},
+                              .memory             = device.memory.host,
+                              .size               = 32 * 1024 * 1024,
+                              .usage              = VK_BUFFER_USAGE_TRANSFER_SRC_BIT,
+                              .sharingMode        = VK_SHARING_MODE_EXCLUSIVE}};
     }
 
     SwapchainCfg
@@ -169,7 +206,9 @@ namespace nd::src::graphics::vulkan
         ND_SET_SCOPE();
 
         return {{.path = "src/graphics/vulkan/shaders/vert.spv", .stage = VK_SHADER_STAGE_VERTEX_BIT},
-                {.path = "src/graphics/vulkan/shaders/frag.spv", .stage = VK_SHADER_STAGE_FRAGMENT_BIT}};
+                {.path = "src/graphics/vulkan/shaders/frag.spv", .stage = VK_SHADER_STAGE_FRAGMENT_BIT},
+                {.path = "src/graphics/vulkan/shaders/meshlet.spv", .stage = VK_SHADER_STAGE_COMPUTE_BIT},
+                {.path = "src/graphics/vulkan/shaders/draw.spv", .stage = VK_SHADER_STAGE_COMPUTE_BIT}};
     }
 
     DescriptorPoolCfg
@@ -177,7 +216,9 @@ namespace nd::src::graphics::vulkan
     {
         ND_SET_SCOPE();
 
-        return {.sizes = {{.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER, .descriptorCount = frameCount}}, .maxSets = frameCount};
+        return {.sizes   = {{.type = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC, .descriptorCount = frameCount},
+                            {.type = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER, .descriptorCount = static_cast<u32>(7 * frameCount)}},
+                .maxSets = static_cast<u16>(3 * frameCount)};
     }
 
     DescriptorSetLayoutObjectsCfg
@@ -185,11 +226,46 @@ namespace nd::src::graphics::vulkan
     {
         ND_SET_SCOPE();
 
-        return {.mesh = {.bindings = {{.binding            = 0,
-                                       .descriptorType     = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER,
-                                       .descriptorCount    = 1,
-                                       .stageFlags         = VK_SHADER_STAGE_VERTEX_BIT,
-                                       .pImmutableSamplers = nullptr}}}};
+        return {.mesh    = {.bindings = {{.binding            = 0,
+                                          .descriptorType     = VK_DESCRIPTOR_TYPE_UNIFORM_BUFFER_DYNAMIC,
+                                          .descriptorCount    = 1,
+                                          .stageFlags         = VK_SHADER_STAGE_VERTEX_BIT,
+                                          .pImmutableSamplers = nullptr}}},
+                .meshlet = {.bindings = {{.binding            = 0,
+                                          .descriptorType     = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                                          .descriptorCount    = 1,
+                                          .stageFlags         = VK_SHADER_STAGE_COMPUTE_BIT,
+                                          .pImmutableSamplers = nullptr},
+                                         {.binding            = 1,
+                                          .descriptorType     = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                                          .descriptorCount    = 1,
+                                          .stageFlags         = VK_SHADER_STAGE_COMPUTE_BIT,
+                                          .pImmutableSamplers = nullptr},
+                                         {.binding            = 2,
+                                          .descriptorType     = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                                          .descriptorCount    = 1,
+                                          .stageFlags         = VK_SHADER_STAGE_COMPUTE_BIT,
+                                          .pImmutableSamplers = nullptr}}},
+                .draw    = {.bindings = {{.binding            = 0,
+                                          .descriptorType     = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                                          .descriptorCount    = 1,
+                                          .stageFlags         = VK_SHADER_STAGE_COMPUTE_BIT,
+                                          .pImmutableSamplers = nullptr},
+                                         {.binding            = 1,
+                                          .descriptorType     = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                                          .descriptorCount    = 1,
+                                          .stageFlags         = VK_SHADER_STAGE_COMPUTE_BIT,
+                                          .pImmutableSamplers = nullptr},
+                                         {.binding            = 2,
+                                          .descriptorType     = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                                          .descriptorCount    = 1,
+                                          .stageFlags         = VK_SHADER_STAGE_COMPUTE_BIT,
+                                          .pImmutableSamplers = nullptr},
+                                         {.binding            = 3,
+                                          .descriptorType     = VK_DESCRIPTOR_TYPE_STORAGE_BUFFER,
+                                          .descriptorCount    = 1,
+                                          .stageFlags         = VK_SHADER_STAGE_COMPUTE_BIT,
+                                          .pImmutableSamplers = nullptr}}}};
     }
 
     PipelineCacheCfg
@@ -205,7 +281,63 @@ namespace nd::src::graphics::vulkan
     {
         ND_SET_SCOPE();
 
-        return {.mesh = {.descriptorSetLayouts = {descriptorSetLayout.mesh}, .pushConstantRanges = {}}};
+        return {.mesh    = {.descriptorSetLayouts = {descriptorSetLayout.mesh}, .pushConstantRanges = {}},
+                .meshlet = {.descriptorSetLayouts = {descriptorSetLayout.meshlet},
+                            .pushConstantRanges   = {{.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT, .offset = 0, .size = 128}}},
+                .draw    = {.descriptorSetLayouts = {descriptorSetLayout.draw},
+                            .pushConstantRanges   = {{.stageFlags = VK_SHADER_STAGE_COMPUTE_BIT, .offset = 0, .size = 128}}}};
+    }
+
+    PipelineVertexInputStateCreateInfo
+    getVertexFormatCfg(const VertexFormat format) noexcept(ND_ASSERT_NOTHROW)
+    {
+        switch(format)
+        {
+            case VertexFormat::full:
+                return {.bindings   = {{.binding = 0U, .stride = 2 * sizeof(glm::vec3), .inputRate = VK_VERTEX_INPUT_RATE_VERTEX}},
+                        .attributes = {{.location = 0U, .binding = 0U, .format = VK_FORMAT_R32G32B32_SFLOAT, .offset = 0U},
+                                       {.location = 1U, .binding = 0U, .format = VK_FORMAT_R32G32B32_SFLOAT, .offset = sizeof(glm::vec3)}}};
+            case VertexFormat::quantized:
+                return {.bindings   = {{.binding = 0U, .stride = 4 * sizeof(i16) + 4 * sizeof(u8), .inputRate = VK_VERTEX_INPUT_RATE_VERTEX}},
+                        .attributes = {{.location = 0U, .binding = 0U, .format = VK_FORMAT_R16G16B16A16_SNORM, .offset = 0U},
+                                       {.location = 1U, .binding = 0U, .format = VK_FORMAT_R8G8B8A8_UNORM, .offset = 4 * sizeof(i16)}}};
+        }
+
+        ND_ASSERT_STATIC();
+
+        return {};
+    }
+
+    PipelineVertexInputStateCreateInfo
+    getVertexInputCfg(const VertexFormat format) noexcept(ND_ASSERT_NOTHROW)
+    {
+        ND_SET_SCOPE();
+
+        auto cfg = getVertexFormatCfg(format);
+
+        cfg.bindings.push_back({.binding = 1U, .stride = sizeof(glm::mat4), .inputRate = VK_VERTEX_INPUT_RATE_INSTANCE});
+
+        for(u32 column = 0; column < 4; ++column)
+        {
+            cfg.attributes.push_back({.location = 2U + column,
+                                      .binding  = 1U,
+                                      .format   = VK_FORMAT_R32G32B32A32_SFLOAT,
+                                      .offset   = column * static_cast<u32>(sizeof(glm::vec4))});
+        }
+
+        return cfg;
+    }
+
+    VkPipelineShaderStageCreateInfo
+    getShaderStageCfg(opt<const ShaderModule>::ref shaderModule) noexcept
+    {
+        return {.sType               = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
+                .pNext               = {},
+                .flags               = {},
+                .stage               = shaderModule.stage,
+                .module              = shaderModule.handle,
+                .pName               = "main",
+                .pSpecializationInfo = {}};
     }
 
     PipelineObjectsCfg
@@ -216,12 +348,24 @@ namespace nd::src::graphics::vulkan
     {
         ND_SET_SCOPE();
 
+        const auto graphicsModules = getFiltered<ShaderModule>(shaderModules,
+                                                               [](const auto& shaderModule, const auto index)
+                                                               {
+                                                                   return shaderModule.stage != VK_SHADER_STAGE_COMPUTE_BIT;
+                                                               });
+
+        const auto computeModules = getFiltered<ShaderModule>(shaderModules,
+                                                              [](const auto& shaderModule, const auto index)
+                                                              {
+                                                                  return shaderModule.stage == VK_SHADER_STAGE_COMPUTE_BIT;
+                                                              });
+
+        ND_ASSERT(computeModules.size() >= 2);
+
         return {
             .mesh = {
                 .depthStencil  = {},
-                .vertexInput   = {.bindings   = {{.binding = 0U, .stride = 2 * sizeof(glm::vec3), .inputRate = VK_VERTEX_INPUT_RATE_VERTEX}},
-                                  .attributes = {{.location = 0U, .binding = 0U, .format = VK_FORMAT_R32G32B32_SFLOAT, .offset = 0U},
-                                               {.location = 1U, .binding = 0U, .format = VK_FORMAT_R32G32B32_SFLOAT, .offset = sizeof(glm::vec3)}}},
+                .vertexInput   = getVertexInputCfg(vertexFormat),
                 .viewport      = {.viewports = {{.x        = 0.0f,
                                                  .y        = 0.0f,
                                                  .width    = static_cast<float>(swapchainCfg.imageExtent.width),
@@ -270,18 +414,11 @@ namespace nd::src::graphics::vulkan
                                   .topology               = VK_PRIMITIVE_TOPOLOGY_TRIANGLE_LIST,
                                   .primitiveRestartEnable = VK_FALSE},
                 .tessellation  = {},
-                .stages        = getMapped<ShaderModule, VkPipelineShaderStageCreateInfo>(
-                    shaderModules,
-                    [](const auto& shaderModule, const auto index)
-                    {
-                        return VkPipelineShaderStageCreateInfo {.sType               = VK_STRUCTURE_TYPE_PIPELINE_SHADER_STAGE_CREATE_INFO,
-                                                                       .pNext               = {},
-                                                                       .flags               = {},
-                                                                       .stage               = shaderModule.stage,
-                                                                       .module              = shaderModule.handle,
-                                                                       .pName               = "main",
-                                                                       .pSpecializationInfo = {}};
-                    }),
+                .stages        = getMapped<ShaderModule, VkPipelineShaderStageCreateInfo>(graphicsModules,
+                                                                                   [](const auto& shaderModule, const auto index)
+                                                                                   {
+                                                                                       return getShaderStageCfg(shaderModule);
+                                                                                   }),
                 .layout           = pipelineLayout.mesh,
                 .renderPass       = renderPass,
                 .subpass          = 0,
@@ -293,7 +430,9 @@ namespace nd::src::graphics::vulkan
                 .multisampleUse   = true,
                 .dynamicStateUse  = false,
                 .inputAssemblyUse = true,
-                .tessellationUse  = false}};
+                .tessellationUse  = false},
+            .meshlet = {.stage = getShaderStageCfg(computeModules[0]), .layout = pipelineLayout.meshlet},
+            .draw    = {.stage = getShaderStageCfg(computeModules[1]), .layout = pipelineLayout.draw}};
     }
 
 
@@ -316,6 +455,9 @@ namespace nd::src::graphics::vulkan
                                                      [&device](const auto index)
                                                      {
                                                          return CommandPoolCfg {.queueFamily = device.queueFamily.compute};
-                                                     })};
+                                                     }),
+                .stream   = {{.queueFamily = device.queueFamily.transfer,
+                              .next        = {},
+                              .flags       = VK_COMMAND_POOL_CREATE_RESET_COMMAND_BUFFER_BIT}}};
     }
 } // namespace nd::src::graphics::vulkan
@@ -17,6 +17,8 @@ namespace nd::src::graphics::vulkan
 
         u16 width;
         u16 height;
+
+        u16 frameCount;
     };
 
     struct InstanceCfg final
@@ -44,7 +46,9 @@ namespace nd::src::graphics::vulkan
 
     struct PhysicalDeviceCfg final
     {
-        VkPhysicalDeviceFeatures features;
+        VkPhysicalDeviceFeatures         features;
+        VkPhysicalDeviceVulkan12Features features12;
+        VkSubgroupFeatureFlags           subgroupOperations;
 
         func<u64(const VkPhysicalDeviceFeatures&, const VkPhysicalDeviceProperties&)> priority;
 
@@ -58,6 +62,9 @@ namespace nd::src::graphics::vulkan
         VkDeviceSize          size;
         VkMemoryPropertyFlags propertyFlags;
         VkMemoryPropertyFlags propertyFlagsNot;
+        VkMemoryPropertyFlags propertyFlagsFallback;
+
+        VkDeviceSize dedicatedSize;
 
         void* next;
     };
@@ -72,6 +79,7 @@ namespace nd::src::graphics::vulkan
     {
         DeviceMemoryCfg device;
         DeviceMemoryCfg host;
+        DeviceMemoryCfg mapped;
     };
 
     struct QueueFamilyObjectsCfg final
@@ -83,12 +91,14 @@ namespace nd::src::graphics::vulkan
 
     struct DeviceCfg final
     {
-        VkPhysicalDeviceFeatures features;
+        VkPhysicalDeviceFeatures         features;
+        VkPhysicalDeviceVulkan12Features features12;
 
         DeviceMemoryObjectsCfg memory;
         QueueFamilyObjectsCfg  queueFamily;
 
         vec<str> extensions;
+        vec<str> extensionsOptional;
 
         VkQueueFlags queueFlags;
 
@@ -128,7 +138,10 @@ namespace nd::src::graphics::vulkan
     struct BufferObjectsCfg final
     {
         BufferCfg mesh;
-        BufferCfg stage;
+        BufferCfg transient;
+        BufferCfg cull;
+        BufferCfg draw;
+        BufferCfg stream;
     };
 
     // --------------- E ---------------
@@ -273,6 +286,8 @@ namespace nd::src::graphics::vulkan
     struct DescriptorSetLayoutObjectsCfg final
     {
         DescriptorSetLayoutCfg mesh;
+        DescriptorSetLayoutCfg meshlet;
+        DescriptorSetLayoutCfg draw;
     };
 
     struct DescriptorSetCfg final
@@ -324,8 +339,18 @@ namespace nd::src::graphics::vulkan
     struct PipelineLayoutObjectsCfg final
     {
         PipelineLayoutCfg mesh;
+        PipelineLayoutCfg meshlet;
+        PipelineLayoutCfg draw;
+    };
+
+    enum class VertexFormat
+    {
+        full,
+        quantized
     };
 
+    constexpr auto vertexFormat = VertexFormat::quantized;
+
     struct PipelineVertexInputStateCreateInfo final
     {
         vec<VkVertexInputBindingDescription>   bindings;
@@ -411,9 +436,21 @@ namespace nd::src::graphics::vulkan
         VkPipelineCreateFlags flags;
     };
 
+    struct ComputePipelineCfg final
+    {
+        VkPipelineShaderStageCreateInfo stage;
+
+        VkPipelineLayout layout;
+
+        void*                 next;
+        VkPipelineCreateFlags flags;
+    };
+
     struct PipelineObjectsCfg final
     {
         GraphicsPipelineCfg mesh;
+        ComputePipelineCfg  meshlet;
+        ComputePipelineCfg  draw;
     };
 
     // ---------------- E ----------------
@@ -443,6 +480,7 @@ namespace nd::src::graphics::vulkan
         vec<CommandPoolCfg> graphics;
         vec<CommandPoolCfg> transfer;
         vec<CommandPoolCfg> compute;
+        vec<CommandPoolCfg> stream;
     };
 
     struct CommandBufferCfg final
@@ -493,6 +531,9 @@ namespace nd::src::graphics::vulkan
 
     PipelineLayoutObjectsCfg getPipelineLayoutObjectsCfg(opt<const DescriptorSetLayoutObjects>::ref) noexcept(ND_ASSERT_NOTHROW);
 
+    PipelineVertexInputStateCreateInfo
+    getVertexInputCfg(const VertexFormat) noexcept(ND_ASSERT_NOTHROW);
+
     PipelineObjectsCfg
     getPipelineObjectsCfg(opt<const SwapchainCfg>::ref,
                           opt<const RenderPass>::ref,
@@ -38,7 +38,7 @@ namespace nd::src::graphics::vulkan
         const auto swapchainFramebufferCfg = cfg.swapchainFramebuffer(swapchainCfg, renderPass);
         auto       swapchainFramebuffers   = init.swapchainFramebuffers(swapchainFramebufferCfg, device.handle, swapchainImageViews);
 
-        const auto descriptorPoolCfg = cfg.descriptorPool(swapchainImages.size());
+        const auto descriptorPoolCfg = cfg.descriptorPool(dependency.frameCount);
         const auto descriptorPool    = init.descriptorPool(descriptorPoolCfg, device.handle);
 
         const auto descriptorSetLayoutCfg = cfg.descriptorSetLayout();
@@ -56,7 +56,9 @@ namespace nd::src::graphics::vulkan
         const auto pipelineCfg = cfg.pipeline(swapchainCfg, renderPass, pipelineLayout, shaderModules);
         const auto pipeline    = init.pipeline(pipelineCfg, device.handle, pipelineCache);
 
-        const auto commandPoolCfg = cfg.commandPool(device, swapchainImages.size(), 1);
+        const auto threadCount = static_cast<u16>(std::clamp(std::thread::hardware_concurrency() / 2, 1U, 4U));
+
+        const auto commandPoolCfg = cfg.commandPool(device, dependency.frameCount, threadCount);
         const auto commandPool    = init.commandPool(commandPoolCfg, device.handle);
 
         return {.device                = device,
@@ -75,7 +77,8 @@ namespace nd::src::graphics::vulkan
                 .surface               = surface,
                 .renderPass            = renderPass,
                 .descriptorPool        = descriptorPool,
-                .pipelineCache         = pipelineCache};
+                .pipelineCache         = pipelineCache,
+                .frameCount            = dependency.frameCount};
     }
 
     void
@@ -110,11 +113,22 @@ namespace nd::src::graphics::vulkan
             vkDestroyCommandPool(objects.device.handle, commandPool, ND_VK_ALLOCATION_CALLBACKS);
         }
 
+        for(opt<const CommandPool>::ref commandPool: objects.commandPool.stream)
+        {
+            vkDestroyCommandPool(objects.device.handle, commandPool, ND_VK_ALLOCATION_CALLBACKS);
+        }
+
         vkDestroyPipeline(objects.device.handle, objects.pipeline.mesh, ND_VK_ALLOCATION_CALLBACKS);
+        vkDestroyPipeline(objects.device.handle, objects.pipeline.meshlet, ND_VK_ALLOCATION_CALLBACKS);
+        vkDestroyPipeline(objects.device.handle, objects.pipeline.draw, ND_VK_ALLOCATION_CALLBACKS);
         vkDestroyPipelineLayout(objects.device.handle, objects.pipelineLayout.mesh, ND_VK_ALLOCATION_CALLBACKS);
+        vkDestroyPipelineLayout(objects.device.handle, objects.pipelineLayout.meshlet, ND_VK_ALLOCATION_CALLBACKS);
+        vkDestroyPipelineLayout(objects.device.handle, objects.pipelineLayout.draw, ND_VK_ALLOCATION_CALLBACKS);
         vkDestroyPipelineCache(objects.device.handle, objects.pipelineCache, ND_VK_ALLOCATION_CALLBACKS);
 
         vkDestroyDescriptorSetLayout(objects.device.handle, objects.descriptorSetLayout.mesh, ND_VK_ALLOCATION_CALLBACKS);
+        vkDestroyDescriptorSetLayout(objects.device.handle, objects.descriptorSetLayout.meshlet, ND_VK_ALLOCATION_CALLBACKS);
+        vkDestroyDescriptorSetLayout(objects.device.handle, objects.descriptorSetLayout.draw, ND_VK_ALLOCATION_CALLBACKS);
         vkDestroyDescriptorPool(objects.device.handle, objects.descriptorPool, ND_VK_ALLOCATION_CALLBACKS);
 
         for(opt<const ShaderModule>::ref shaderModule: objects.shaderModules)
@@ -136,11 +150,15 @@ namespace nd::src::graphics::vulkan
         vkDestroySwapchainKHR(objects.device.handle, objects.swapchain.handle, ND_VK_ALLOCATION_CALLBACKS);
         vkDestroySurfaceKHR(objects.instance, objects.surface, ND_VK_ALLOCATION_CALLBACKS);
 
-        vkDestroyBuffer(objects.device.handle, objects.buffer.mesh.handle, ND_VK_ALLOCATION_CALLBACKS);
-        vkDestroyBuffer(objects.device.handle, objects.buffer.stage.handle, ND_VK_ALLOCATION_CALLBACKS);
+        destroyBuffer(objects.buffer.mesh, objects.device.handle);
+        destroyBuffer(objects.buffer.transient, objects.device.handle);
+        destroyBuffer(objects.buffer.cull, objects.device.handle);
+        destroyBuffer(objects.buffer.draw, objects.device.handle);
+        destroyBuffer(objects.buffer.stream, objects.device.handle);
 
-        vkFreeMemory(objects.device.handle, objects.device.memory.device.handle, ND_VK_ALLOCATION_CALLBACKS);
-        vkFreeMemory(objects.device.handle, objects.device.memory.host.handle, ND_VK_ALLOCATION_CALLBACKS);
+        freeMemory(objects.device.memory.device, objects.device.handle);
+        freeMemory(objects.device.memory.host, objects.device.handle);
+        freeMemory(objects.device.memory.mapped, objects.device.handle);
 
         vkDestroyDevice(objects.device.handle, ND_VK_ALLOCATION_CALLBACKS);
         vkDestroyInstance(objects.instance, ND_VK_ALLOCATION_CALLBACKS);
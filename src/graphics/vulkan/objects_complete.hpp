@@ -7,6 +7,10 @@
 #include "objects_init_builder.hpp"
 
 #include "sync_init.hpp"
+#include "staging.hpp"
+#include "transient.hpp"
+#include "defragment.hpp"
+#include "growable.hpp"
 
 namespace nd::src::graphics::vulkan
 {
@@ -65,6 +65,20 @@ namespace nd::src::graphics::vulkan
                                              .basePipelineIndex   = -1};
     }
 
+    VkComputePipelineCreateInfo
+    getComputePipelineCreateInfo(opt<const ComputePipelineCfg>::ref cfg) noexcept
+    {
+        ND_SET_SCOPE();
+
+        return VkComputePipelineCreateInfo {.sType              = VK_STRUCTURE_TYPE_COMPUTE_PIPELINE_CREATE_INFO,
+                                            .pNext              = cfg.next,
+                                            .flags              = cfg.flags,
+                                            .stage              = cfg.stage,
+                                            .layout             = cfg.layout,
+                                            .basePipelineHandle = VK_NULL_HANDLE,
+                                            .basePipelineIndex  = -1};
+    }
+
     PipelineCache
     createPipelineCache(opt<const PipelineCacheCfg>::ref cfg, const VkDevice device) noexcept(ND_VK_ASSERT_NOTHROW)
     {
@@ -108,7 +122,9 @@ namespace nd::src::graphics::vulkan
     {
         ND_SET_SCOPE();
 
-        return {.mesh = createPipelineLayout(cfg.mesh, device)};
+        return {.mesh    = createPipelineLayout(cfg.mesh, device),
+                .meshlet = createPipelineLayout(cfg.meshlet, device),
+                .draw    = createPipelineLayout(cfg.draw, device)};
     }
 
     PipelineObjects
@@ -131,6 +147,17 @@ namespace nd::src::graphics::vulkan
                                                ND_VK_ALLOCATION_CALLBACKS,
                                                graphicsPipelines.data()));
 
-        return {.mesh = graphicsPipelines[0]};
+        auto computeCreateInfos = array {getComputePipelineCreateInfo(cfg.meshlet), getComputePipelineCreateInfo(cfg.draw)};
+
+        auto computePipelines = array<VkPipeline, computeCreateInfos.size()> {};
+
+        ND_VK_ASSERT(vkCreateComputePipelines(device,
+                                              pipelineCache,
+                                              computeCreateInfos.size(),
+                                              computeCreateInfos.data(),
+                                              ND_VK_ALLOCATION_CALLBACKS,
+                                              computePipelines.data()));
+
+        return {.mesh = graphicsPipelines[0], .meshlet = computePipelines[0], .draw = computePipelines[1]};
     }
 } // namespace nd::src::graphics::vulkan
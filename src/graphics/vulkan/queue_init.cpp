@@ -65,6 +65,19 @@ namespace nd::src::graphics::vulkan
                 .pSignalSemaphores    = cfg.semaphoresSignal.data()};
     }
 
+    TimelineSubmitInfo
+    getTimelineSubmitInfo(opt<const TimelineSubmitInfoCfg>::ref cfg) noexcept
+    {
+        ND_SET_SCOPE();
+
+        return {.sType                     = VK_STRUCTURE_TYPE_TIMELINE_SEMAPHORE_SUBMIT_INFO,
+                .pNext                     = cfg.next,
+                .waitSemaphoreValueCount   = static_cast<u32>(cfg.valuesWait.size()),
+                .pWaitSemaphoreValues      = cfg.valuesWait.data(),
+                .signalSemaphoreValueCount = static_cast<u32>(cfg.valuesSignal.size()),
+                .pSignalSemaphoreValues    = cfg.valuesSignal.data()};
+    }
+
     PresentInfo
     getPresentInfo(opt<const PresentInfoCfg>::ref cfg) noexcept(ND_ASSERT_NOTHROW)
     {
@@ -4,8 +4,9 @@
 
 namespace nd::src::graphics::vulkan
 {
-    using SubmitInfo  = VkSubmitInfo;
-    using PresentInfo = VkPresentInfoKHR;
+    using SubmitInfo         = VkSubmitInfo;
+    using TimelineSubmitInfo = VkTimelineSemaphoreSubmitInfo;
+    using PresentInfo        = VkPresentInfoKHR;
 
     struct SubmitInfoCfg final
     {
@@ -17,6 +18,14 @@ namespace nd::src::graphics::vulkan
         void* next = {};
     };
 
+    struct TimelineSubmitInfoCfg final
+    {
+        span<const u64> valuesWait;
+        span<const u64> valuesSignal;
+
+        void* next = {};
+    };
+
     struct PresentInfoCfg final
     {
         span<const VkSemaphore>    semaphoresWait;
@@ -37,5 +46,7 @@ namespace nd::src::graphics::vulkan
 
     SubmitInfo getSubmitInfo(opt<const SubmitInfoCfg>::ref) noexcept(ND_ASSERT_NOTHROW);
 
+    TimelineSubmitInfo getTimelineSubmitInfo(opt<const TimelineSubmitInfoCfg>::ref) noexcept;
+
     PresentInfo getPresentInfo(opt<const PresentInfoCfg>::ref) noexcept(ND_ASSERT_NOTHROW);
 } // namespace nd::src::graphics::vulkan
@@ -0,0 +1,179 @@
+#version 460
+
+#extension GL_KHR_shader_subgroup_basic : require
+#extension GL_KHR_shader_subgroup_ballot : require
+
+layout(local_size_x = 64) in;
+
+struct Lod
+{
+    uint  firstIndex;
+    uint  indexCount;
+    float error;
+    uint  reserved;
+};
+
+struct Mesh
+{
+    int  vertexOffset;
+    uint lodCount;
+    uint indexShort;
+    uint reserved;
+
+    Lod lods[8];
+};
+
+struct Instance
+{
+    mat4 model;
+    vec4 sphere;
+
+    uint  meshIndex;
+    uint  skip;
+    float scale;
+    uint  reserved;
+};
+
+struct Command
+{
+    uint indexCount;
+    uint instanceCount;
+    uint firstIndex;
+    int  vertexOffset;
+    uint firstInstance;
+};
+
+layout(std430, binding = 0) readonly buffer MeshBuffer
+{
+    Mesh meshes[];
+};
+
+layout(std430, binding = 1) readonly buffer InstanceBuffer
+{
+    Instance instances[];
+};
+
+layout(std430, binding = 2) buffer DrawBuffer
+{
+    uint    counts[4];
+    Command commands[];
+};
+
+layout(std430, binding = 3) writeonly buffer VisibleBuffer
+{
+    mat4 models[];
+};
+
+layout(push_constant) uniform Constants
+{
+    vec4  planes[6];
+    vec3  eye;
+    float projection;
+    float errorMax;
+    float near;
+    float far;
+} constants;
+
+bool isVisible(const Instance instance)
+{
+    for(uint plane = 0; plane < 6; ++plane)
+    {
+        if(dot(constants.planes[plane].xyz, instance.sphere.xyz) + constants.planes[plane].w < -instance.sphere.w)
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+
+uint getLod(const Mesh mesh, const Instance instance)
+{
+    if(mesh.lodCount < 2)
+    {
+        return 0;
+    }
+
+    const float distance = max(length(instance.sphere.xyz - constants.eye) - instance.sphere.w, constants.near);
+
+    if(distance > constants.far)
+    {
+        return mesh.lodCount - 1;
+    }
+
+    uint lod = 0;
+
+    while(lod + 1 < mesh.lodCount && mesh.lods[lod + 1].error * instance.scale * constants.projection / distance <= constants.errorMax)
+    {
+        ++lod;
+    }
+
+    return lod;
+}
+
+uint getCompacted(const bool taken, const uint counter)
+{
+    const uvec4 ballot = subgroupBallot(taken);
+
+    uint base = 0;
+
+    if(subgroupElect())
+    {
+        base = atomicAdd(counts[counter], subgroupBallotBitCount(ballot));
+    }
+
+    return subgroupBroadcastFirst(base) + subgroupBallotExclusiveBitCount(ballot);
+}
+
+void main()
+{
+    const uint index = gl_GlobalInvocationID.x;
+
+    bool visible    = index < instances.length();
+    bool indexShort = false;
+
+    Instance instance;
+    Mesh     mesh;
+
+    if(visible)
+    {
+        instance = instances[index];
+        visible  = instance.skip == 0 && instance.meshIndex < meshes.length();
+    }
+
+    if(visible)
+    {
+        mesh       = meshes[instance.meshIndex];
+        visible    = mesh.lodCount != 0 && isVisible(instance);
+        indexShort = mesh.indexShort != 0;
+    }
+
+    const uint slot         = getCompacted(visible, 2);
+    const uint commandShort = getCompacted(visible && indexShort, 0);
+    const uint commandLong  = getCompacted(visible && !indexShort, 1);
+
+    const uint instanceMax = models.length();
+    const uint compacted   = indexShort ? commandShort : commandLong;
+
+    if(!visible || compacted >= instanceMax)
+    {
+        return;
+    }
+
+    const uint command = (indexShort ? 0 : instanceMax) + compacted;
+
+    if(slot >= instanceMax)
+    {
+        commands[command] = Command(0, 0, 0, 0, 0);
+
+        return;
+    }
+
+    const Lod lod = mesh.lods[getLod(mesh, instance)];
+
+    models[slot] = instance.model;
+
+    commands[command] = Command(lod.indexCount, 1, lod.firstIndex, mesh.vertexOffset, slot);
+
+    return;
+}
@@ -0,0 +1,105 @@
+#version 460
+
+layout(local_size_x = 64) in;
+
+struct Meshlet
+{
+    vec4 sphere;
+    vec4 cone;
+
+    uint firstIndex;
+    uint indexCount;
+    uint reserved0;
+    uint reserved1;
+};
+
+layout(std430, binding = 0) readonly buffer MeshletBuffer
+{
+    Meshlet meshlets[];
+};
+
+layout(std430, binding = 1) readonly buffer IndexBuffer
+{
+    uint indices[];
+};
+
+layout(std430, binding = 2) buffer CullBuffer
+{
+    uint cull[];
+};
+
+layout(push_constant) uniform Constants
+{
+    vec4 planes[6];
+    vec3 eye;
+    uint firstMeshlet;
+    uint meshletCount;
+    uint firstIndex;
+    uint indexShort;
+    uint command;
+} constants;
+
+shared uint visible;
+shared uint base;
+
+bool isVisible(const Meshlet meshlet)
+{
+    const vec3  center = meshlet.sphere.xyz;
+    const float radius = meshlet.sphere.w;
+
+    for(uint plane = 0; plane < 6; ++plane)
+    {
+        if(dot(constants.planes[plane].xyz, center) + constants.planes[plane].w < -radius)
+        {
+            return false;
+        }
+    }
+
+    const vec3 direction = center - constants.eye;
+
+    return dot(direction, meshlet.cone.xyz) < meshlet.cone.w * length(direction) + radius;
+}
+
+uint getIndex(const uint index)
+{
+    if(constants.indexShort == 0)
+    {
+        return indices[index];
+    }
+
+    return (indices[index >> 1] >> ((index & 1) * 16)) & 0xFFFF;
+}
+
+void main()
+{
+    if(gl_WorkGroupID.x >= constants.meshletCount)
+    {
+        return;
+    }
+
+    const Meshlet meshlet = meshlets[constants.firstMeshlet + gl_WorkGroupID.x];
+
+    if(gl_LocalInvocationIndex == 0)
+    {
+        visible = isVisible(meshlet) ? 1 : 0;
+
+        if(visible != 0)
+        {
+            base = cull[constants.command + 2] + atomicAdd(cull[constants.command], meshlet.indexCount);
+        }
+    }
+
+    barrier();
+
+    if(visible == 0)
+    {
+        return;
+    }
+
+    for(uint index = gl_LocalInvocationIndex; index < meshlet.indexCount; index += gl_WorkGroupSize.x)
+    {
+        cull[base + index] = getIndex(constants.firstIndex + meshlet.firstIndex + index);
+    }
+
+    return;
+}
@@ -8,11 +8,13 @@ layout(binding = 0) uniform UniformBufferObject
 layout(location = 0) in vec3 positionIn;
 layout(location = 1) in vec3 colorIn;
 
+layout(location = 2) in mat4 modelIn;
+
 layout(location = 0) out vec3 colorOut;
 
 void main()
 { 
-    gl_Position = ubo.transform * vec4(positionIn, 1.0);
+    gl_Position = ubo.transform * modelIn * vec4(positionIn, 1.0);
 
     colorOut = colorIn;
 
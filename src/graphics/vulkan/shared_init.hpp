@@ -5,8 +5,9 @@
 
 #include "objects.hpp"
 #include "objects_cfg.hpp"
+#include "host_allocator.hpp"
 
-#define ND_VK_ALLOCATION_CALLBACKS (nullptr)
+#define ND_VK_ALLOCATION_CALLBACKS (nd::src::graphics::vulkan::getHostAllocationCallbacks())
 
 #define ND_VK_ASSERT_NOTHROW (ND_ASSERT_NOTHROW)
 #define ND_VK_ASSERT(result) \
@@ -0,0 +1,212 @@
+#include "staging.hpp"
+#include "memory_init.hpp"
+#include "tools_runtime.hpp"
+
+namespace nd::src::graphics::vulkan
+{
+    using namespace nd::src::tools;
+
+    StagingRing
+    getStagingRing(opt<const Buffer>::ref buffer, const u16 frameCount) noexcept(ND_ASSERT_NOTHROW)
+    {
+        ND_SET_SCOPE();
+
+        ND_ASSERT(buffer.memory.data);
+
+        return {.buffer     = buffer,
+                .data       = static_cast<std::byte*>(buffer.memory.data) + buffer.offset,
+                .alignment  = 16,
+                .head       = 0,
+                .tail       = 0,
+                .frameHeads = vec<VkDeviceSize>(frameCount, 0ULL),
+                .uploads    = {},
+                .copies     = {}};
+    }
+
+    StagingRegion
+    getStagingRegion(StagingRing& ring, const VkDeviceSize size) noexcept
+    {
+        ND_SET_SCOPE();
+
+        const auto ringSize = ring.buffer.size;
+        const auto ringFree = ringSize - (ring.head - ring.tail);
+
+        const auto position = ring.head % ringSize;
+        const auto padding  = std::min(getMemoryOffsetAligned(position, ring.alignment), ringSize) - position;
+
+        if(padding >= ringFree)
+        {
+            return {};
+        }
+
+        const auto offset = (position + padding) % ringSize;
+        const auto length = std::min({size, ringSize - offset, ringFree - padding});
+
+        ring.head += padding + length;
+
+        return {.offset = offset, .size = length};
+    }
+
+    VkDeviceSize
+    setStagingRegions(StagingRing& ring, const VkBuffer buffer, const VkDeviceSize offset, const span<const std::byte> data) noexcept
+    {
+        ND_SET_SCOPE();
+
+        auto staged = 0ULL;
+
+        while(staged < data.size())
+        {
+            const auto region = getStagingRegion(ring, data.size() - staged);
+
+            if(!region.size)
+            {
+                break;
+            }
+
+            std::memcpy(ring.data + region.offset, data.data() + staged, region.size);
+
+            ring.copies[buffer].push_back({.srcOffset = region.offset, .dstOffset = offset + staged, .size = region.size});
+
+            staged += region.size;
+        }
+
+        return staged;
+    }
+
+    void
+    setStagingQueued(StagingRing& ring, const VkBuffer buffer, const VkDeviceSize offset, const span<const std::byte> data, const bool owned) noexcept
+    {
+        const auto staged = ring.uploads.empty() ? setStagingRegions(ring, buffer, offset, data) : 0ULL;
+
+        if(staged == data.size())
+        {
+            return;
+        }
+
+        auto& upload = ring.uploads.emplace_back(
+            StagingUpload {.buffer = buffer, .offset = offset + staged, .staged = 0, .data = {}, .view = data.subspan(staged)});
+
+        if(owned)
+        {
+            upload.data = vec<std::byte>(upload.view.begin(), upload.view.end());
+            upload.view = upload.data;
+        }
+    }
+
+    void
+    setStagingUpload(StagingRing& ring, const VkBuffer buffer, const VkDeviceSize offset, const span<const std::byte> data) noexcept
+    {
+        ND_SET_SCOPE();
+
+        setStagingQueued(ring, buffer, offset, data, true);
+    }
+
+    void
+    setStagingUpload(StagingRing& ring, opt<const Buffer>::ref buffer, const VkDeviceSize offset, const span<const std::byte> data) noexcept
+    {
+        ND_SET_SCOPE();
+
+        if(!buffer.memory.data)
+        {
+            setStagingUpload(ring, buffer.handle, offset, data);
+
+            return;
+        }
+
+        std::memcpy(static_cast<std::byte*>(buffer.memory.data) + buffer.offset + offset, data.data(), data.size());
+    }
+
+    void
+    setStagingStream(StagingRing& ring, opt<const Buffer>::ref buffer, const VkDeviceSize offset, const span<const std::byte> data) noexcept
+    {
+        ND_SET_SCOPE();
+
+        if(!buffer.memory.data)
+        {
+            setStagingQueued(ring, buffer.handle, offset, data, false);
+
+            return;
+        }
+
+        std::memcpy(static_cast<std::byte*>(buffer.memory.data) + buffer.offset + offset, data.data(), data.size());
+    }
+
+    VkDeviceSize
+    getStagingFree(const StagingRing& ring) noexcept
+    {
+        ND_SET_SCOPE();
+
+        return ring.buffer.size - (ring.head - ring.tail);
+    }
+
+    bool
+    isStagingPending(const StagingRing& ring) noexcept
+    {
+        ND_SET_SCOPE();
+
+        return !ring.uploads.empty() || !ring.copies.empty();
+    }
+
+    void
+    setStagingTarget(StagingRing& ring, const VkBuffer buffer, const VkBuffer target) noexcept
+    {
+        ND_SET_SCOPE();
+
+        if(buffer == target)
+        {
+            return;
+        }
+
+        for(auto& upload: ring.uploads)
+        {
+            upload.buffer = upload.buffer == buffer ? target : upload.buffer;
+        }
+
+        const auto copies = ring.copies.find(buffer);
+
+        if(copies != ring.copies.end())
+        {
+            auto& targetCopies = ring.copies[target];
+
+            targetCopies.insert(targetCopies.end(), copies->second.begin(), copies->second.end());
+
+            ring.copies.erase(buffer);
+        }
+    }
+
+    void
+    setStagingCopies(StagingRing& ring, const VkCommandBuffer commandBuffer, const u16 frameIndex) noexcept
+    {
+        ND_SET_SCOPE();
+
+        while(!ring.uploads.empty())
+        {
+            auto& upload = ring.uploads.front();
+
+            upload.staged += setStagingRegions(ring, upload.buffer, upload.offset + upload.staged, upload.view.subspan(upload.staged));
+
+            if(upload.staged < upload.view.size())
+            {
+                break;
+            }
+
+            ring.uploads.pop_front();
+        }
+
+        for(const auto& [buffer, copies]: ring.copies)
+        {
+            vkCmdCopyBuffer(commandBuffer, ring.buffer.handle, buffer, static_cast<u32>(copies.size()), copies.data());
+        }
+
+        ring.copies.clear();
+        ring.frameHeads[frameIndex] = ring.head;
+    }
+
+    void
+    resetStagingRing(StagingRing& ring, const u16 frameIndex) noexcept
+    {
+        ND_SET_SCOPE();
+
+        ring.tail = std::max(ring.tail, ring.frameHeads[frameIndex]);
+    }
+} // namespace nd::src::graphics::vulkan
@@ -0,0 +1,70 @@
+#pragma once
+
+#include "shared_init.hpp"
+
+namespace nd::src::graphics::vulkan
+{
+    struct StagingRegion final
+    {
+        VkDeviceSize offset;
+        VkDeviceSize size;
+    };
+
+    struct StagingUpload final
+    {
+        VkBuffer     buffer;
+        VkDeviceSize offset;
+        VkDeviceSize staged;
+
+        vec<std::byte>        data;
+        span<const std::byte> view;
+    };
+
+    struct StagingRing final
+    {
+        Buffer buffer;
+
+        std::byte*   data;
+        VkDeviceSize alignment;
+
+        VkDeviceSize head;
+        VkDeviceSize tail;
+
+        vec<VkDeviceSize>                  frameHeads;
+        std::deque<StagingUpload>          uploads;
+        map<VkBuffer, vec<VkBufferCopy>> copies;
+    };
+
+    StagingRing
+    getStagingRing(opt<const Buffer>::ref, const u16) noexcept(ND_ASSERT_NOTHROW);
+
+    StagingRegion
+    getStagingRegion(StagingRing&, const VkDeviceSize) noexcept;
+
+    VkDeviceSize
+    setStagingRegions(StagingRing&, const VkBuffer, const VkDeviceSize, const span<const std::byte>) noexcept;
+
+    void
+    setStagingUpload(StagingRing&, const VkBuffer, const VkDeviceSize, const span<const std::byte>) noexcept;
+
+    void
+    setStagingUpload(StagingRing&, opt<const Buffer>::ref, const VkDeviceSize, const span<const std::byte>) noexcept;
+
+    void
+    setStagingStream(StagingRing&, opt<const Buffer>::ref, const VkDeviceSize, const span<const std::byte>) noexcept;
+
+    VkDeviceSize
+    getStagingFree(const StagingRing&) noexcept;
+
+    bool
+    isStagingPending(const StagingRing&) noexcept;
+
+    void
+    setStagingTarget(StagingRing&, const VkBuffer, const VkBuffer) noexcept;
+
+    void
+    setStagingCopies(StagingRing&, const VkCommandBuffer, const u16) noexcept;
+
+    void
+    resetStagingRing(StagingRing&, const u16) noexcept;
+} // namespace nd::src::graphics::vulkan
@@ -33,6 +33,32 @@ namespace nd::src::graphics::vulkan
                                     });
     }
 
+    Semaphore
+    createTimeline(Objects& objects, opt<const TimelineCfg>::ref cfg) noexcept(ND_VK_ASSERT_NOTHROW)
+    {
+        ND_SET_SCOPE();
+
+        auto typeCreateInfo = VkSemaphoreTypeCreateInfo {.sType         = VK_STRUCTURE_TYPE_SEMAPHORE_TYPE_CREATE_INFO,
+                                                         .pNext         = cfg.next,
+                                                         .semaphoreType = VK_SEMAPHORE_TYPE_TIMELINE,
+                                                         .initialValue  = cfg.value};
+
+        return createSemaphore(objects, {.next = &typeCreateInfo});
+    }
+
+    void
+    setTimelineWait(const VkDevice device, const Semaphore semaphore, const u64 value) noexcept(ND_VK_ASSERT_NOTHROW)
+    {
+        ND_SET_SCOPE();
+
+        const auto waitInfo = VkSemaphoreWaitInfo {.sType          = VK_STRUCTURE_TYPE_SEMAPHORE_WAIT_INFO,
+                                                   .semaphoreCount = 1,
+                                                   .pSemaphores    = &semaphore,
+                                                   .pValues        = &value};
+
+        ND_VK_ASSERT(vkWaitSemaphores(device, &waitInfo, std::numeric_limits<u64>::max()));
+    }
+
     Fence
     createFence(Objects& objects, opt<const FenceCfg>::ref cfg) noexcept(ND_VK_ASSERT_NOTHROW)
     {
@@ -10,6 +10,12 @@ namespace nd::src::graphics::vulkan
         VkSemaphoreCreateFlags flags = {};
     };
 
+    struct TimelineCfg final
+    {
+        void* next  = {};
+        u64   value = {};
+    };
+
     struct FenceCfg final
     {
         void*              next  = {};
@@ -22,6 +28,12 @@ namespace nd::src::graphics::vulkan
     vec<Semaphore>
     createSemaphores(Objects&, opt<const SemaphoreCfg>::ref, const u16) noexcept(ND_VK_ASSERT_NOTHROW);
 
+    Semaphore
+    createTimeline(Objects&, opt<const TimelineCfg>::ref) noexcept(ND_VK_ASSERT_NOTHROW);
+
+    void
+    setTimelineWait(const VkDevice, const Semaphore, const u64) noexcept(ND_VK_ASSERT_NOTHROW);
+
     Fence
     createFence(Objects&, opt<const FenceCfg>::ref) noexcept(ND_VK_ASSERT_NOTHROW);
 
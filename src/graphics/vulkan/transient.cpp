@@ -0,0 +1,74 @@
+#include "transient.hpp"
+#include "memory_init.hpp"
+#include "tools_runtime.hpp"
+
+namespace nd::src::graphics::vulkan
+{
+    using namespace nd::src::tools;
+
+    TransientAllocator
+    getTransientAllocator(opt<const Buffer>::ref buffer, const VkDeviceSize alignment, const u16 frameCount) noexcept(ND_ASSERT_NOTHROW)
+    {
+        ND_SET_SCOPE();
+
+        ND_ASSERT(buffer.memory.data && frameCount);
+
+        const auto frameSize = buffer.size / frameCount / alignment * alignment;
+
+        ND_ASSERT(frameSize);
+
+        return {.buffer     = buffer,
+                .data       = static_cast<std::byte*>(buffer.memory.data) + buffer.offset,
+                .alignment  = alignment,
+                .frameSize  = frameSize,
+                .head       = 0,
+                .frameIndex = 0};
+    }
+
+    VkDeviceSize
+    getTransientSpace(const TransientAllocator& allocator) noexcept
+    {
+        ND_SET_SCOPE();
+
+        const auto head = getMemoryOffsetAligned(allocator.head, allocator.alignment);
+
+        return allocator.frameSize - std::min(head, allocator.frameSize);
+    }
+
+    TransientSlice
+    getTransientSlice(TransientAllocator& allocator, const VkDeviceSize size) noexcept(ND_ASSERT_NOTHROW)
+    {
+        ND_SET_SCOPE();
+
+        const auto head = getMemoryOffsetAligned(allocator.head, allocator.alignment);
+
+        ND_ASSERT(head + size <= allocator.frameSize);
+
+        const auto offset = allocator.frameSize * allocator.frameIndex + head;
+
+        allocator.head = head + size;
+
+        return {.buffer = allocator.buffer.handle, .offset = offset, .size = size, .data = allocator.data + offset};
+    }
+
+    TransientSlice
+    setTransientData(TransientAllocator& allocator, const span<const std::byte> data) noexcept(ND_ASSERT_NOTHROW)
+    {
+        ND_SET_SCOPE();
+
+        const auto slice = getTransientSlice(allocator, data.size());
+
+        std::memcpy(slice.data, data.data(), data.size());
+
+        return slice;
+    }
+
+    void
+    resetTransientAllocator(TransientAllocator& allocator, const u16 frameIndex) noexcept
+    {
+        ND_SET_SCOPE();
+
+        allocator.head       = 0;
+        allocator.frameIndex = frameIndex;
+    }
+} // namespace nd::src::graphics::vulkan
@@ -0,0 +1,42 @@
+#pragma once
+
+#include "shared_init.hpp"
+
+namespace nd::src::graphics::vulkan
+{
+    struct TransientSlice final
+    {
+        VkBuffer     buffer;
+        VkDeviceSize offset;
+        VkDeviceSize size;
+
+        std::byte* data;
+    };
+
+    struct TransientAllocator final
+    {
+        Buffer buffer;
+
+        std::byte*   data;
+        VkDeviceSize alignment;
+        VkDeviceSize frameSize;
+
+        VkDeviceSize head;
+        u16          frameIndex;
+    };
+
+    TransientAllocator
+    getTransientAllocator(opt<const Buffer>::ref, const VkDeviceSize, const u16) noexcept(ND_ASSERT_NOTHROW);
+
+    VkDeviceSize
+    getTransientSpace(const TransientAllocator&) noexcept;
+
+    TransientSlice
+    getTransientSlice(TransientAllocator&, const VkDeviceSize) noexcept(ND_ASSERT_NOTHROW);
+
+    TransientSlice
+    setTransientData(TransientAllocator&, const span<const std::byte>) noexcept(ND_ASSERT_NOTHROW);
+
+    void
+    resetTransientAllocator(TransientAllocator&, const u16) noexcept;
+} // namespace nd::src::graphics::vulkan
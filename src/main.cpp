@@ -35,8 +35,8 @@ main()
     const auto maxSize  = 1024 * 1024 * 8;
     const auto maxFiles = 8;
 
-    auto fileSinkMainPtr  = shared<rotating_file_sink_st>(new rotating_file_sink_st("log/log.txt", maxSize, maxFiles));
-    auto fileSinkScopePtr = shared<rotating_file_sink_st>(new rotating_file_sink_st("log/scope.txt", maxSize, maxFiles));
+    auto fileSinkMainPtr  = shared<rotating_file_sink_mt>(new rotating_file_sink_mt("log/log.txt", maxSize, maxFiles));
+    auto fileSinkScopePtr = shared<rotating_file_sink_mt>(new rotating_file_sink_mt("log/scope.txt", maxSize, maxFiles));
 
     auto logMain  = shared<logger>(new logger(logMainName, {fileSinkMainPtr}));
     auto logScope = shared<logger>(new logger(logScopeName, {fileSinkScopePtr}));
@@ -61,7 +61,8 @@ main()
                                         .layers          = {},
                                         .extensions      = getGlfwRequiredExtensions(),
                                         .width           = window.width,
-                                        .height          = window.height},
+                                        .height          = window.height,
+                                        .frameCount      = 2},
                                        ObjectsCfgBuilder::getDefault(),
                                        ObjectsInitBuilder::getDefault() << createSurfaceLambda);
 
@@ -74,6 +75,7 @@ main()
         draw(vulkanObjects, getDt(deltaMin));
     }
 
+    destroyDraw(vulkanObjects);
     destroyObjects(vulkanObjects);
 
     glfwTerminate();
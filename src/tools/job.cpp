@@ -0,0 +1,422 @@
+#include "job.hpp"
+#include "tools_runtime.hpp"
+
+#if defined(__linux__)
+    #include <pthread.h>
+    #include <sched.h>
+#endif
+
+namespace nd::src::tools
+{
+    thread_local const JobQueue* s_jobQueue       = {};
+    thread_local u16             s_jobThreadIndex = {};
+
+    constexpr auto jobDequeMask = static_cast<i64>(jobDequeCapacity - 1);
+
+    constexpr auto jobWaitSpinMax = 64U;
+
+    static_assert(std::has_single_bit(jobDequeCapacity));
+
+    bool
+    setJobPushed(JobDeque& deque, Job* job) noexcept
+    {
+        const auto bottom = deque.bottom.load(std::memory_order_relaxed);
+        const auto top    = deque.top.load(std::memory_order_acquire);
+
+        if(bottom - top >= static_cast<i64>(jobDequeCapacity))
+        {
+            return false;
+        }
+
+        deque.jobs[bottom & jobDequeMask].store(job, std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_release);
+
+        deque.bottom.store(bottom + 1, std::memory_order_relaxed);
+
+        return true;
+    }
+
+    Job*
+    getJobPopped(JobDeque& deque) noexcept
+    {
+        const auto bottom = deque.bottom.load(std::memory_order_relaxed) - 1;
+
+        deque.bottom.store(bottom, std::memory_order_relaxed);
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        auto top = deque.top.load(std::memory_order_relaxed);
+
+        if(top > bottom)
+        {
+            deque.bottom.store(bottom + 1, std::memory_order_relaxed);
+
+            return nullptr;
+        }
+
+        auto job = deque.jobs[bottom & jobDequeMask].load(std::memory_order_relaxed);
+
+        if(top == bottom)
+        {
+            if(!deque.top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+            {
+                job = nullptr;
+            }
+
+            deque.bottom.store(bottom + 1, std::memory_order_relaxed);
+        }
+
+        return job;
+    }
+
+    Job*
+    getJobStolen(JobDeque& deque) noexcept
+    {
+        auto top = deque.top.load(std::memory_order_acquire);
+
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+
+        const auto bottom = deque.bottom.load(std::memory_order_acquire);
+
+        if(top >= bottom)
+        {
+            return nullptr;
+        }
+
+        const auto job = deque.jobs[top & jobDequeMask].load(std::memory_order_relaxed);
+
+        if(!deque.top.compare_exchange_strong(top, top + 1, std::memory_order_seq_cst, std::memory_order_relaxed))
+        {
+            return nullptr;
+        }
+
+        return job;
+    }
+
+    Job*
+    getJobNext(JobQueue& queue, const u16 threadIndex) noexcept
+    {
+        if(const auto job = getJobPopped(queue.deques[threadIndex]))
+        {
+            return job;
+        }
+
+        for(u16 offset = 1; offset < queue.threadCount; ++offset)
+        {
+            if(const auto job = getJobStolen(queue.deques[(threadIndex + offset) % queue.threadCount]))
+            {
+                return job;
+            }
+        }
+
+        return nullptr;
+    }
+
+    Job*
+    getJobWaited(JobQueue& queue, const u16 threadIndex) noexcept
+    {
+        for(u16 offset = 1; offset < queue.threadCount; ++offset)
+        {
+            if(const auto job = getJobStolen(queue.deques[(threadIndex + offset) % queue.threadCount]))
+            {
+                return job;
+            }
+        }
+
+        return getJobPopped(queue.deques[threadIndex]);
+    }
+
+    void
+    setJobRun(JobQueue&, const Job&) noexcept;
+
+    void
+    setJobsNotified(JobQueue& queue) noexcept
+    {
+        {
+            const auto lock = std::lock_guard {queue.mutex};
+
+            queue.generation.fetch_add(1, std::memory_order_release);
+        }
+
+        queue.condition.notify_all();
+    }
+
+    void
+    setJobsPushed(JobQueue& queue, const span<Job* const> jobs) noexcept
+    {
+        for(const auto job: jobs)
+        {
+            if(!setJobPushed(queue.deques[s_jobThreadIndex], job))
+            {
+                setJobRun(queue, *job);
+            }
+        }
+
+        setJobsNotified(queue);
+    }
+
+    void
+    setJobRun(JobQueue& queue, const Job& job) noexcept
+    {
+        (*job.function)(job.first, job.last);
+
+        auto& counter = *job.counter;
+
+        auto released = vec<Job*> {};
+        auto drained  = false;
+
+        // a waiter may destroy the counter as soon as it sees it drained
+        {
+            const auto lock = std::lock_guard {counter.mutex};
+
+            if(--counter.pending == 0)
+            {
+                released.swap(counter.waiting);
+
+                drained = true;
+            }
+        }
+
+        if(!released.empty())
+        {
+            setJobsPushed(queue, released);
+
+            return;
+        }
+
+        if(drained)
+        {
+            setJobsNotified(queue);
+        }
+    }
+
+    void
+    setJobsDeferred(JobQueue& queue, vec<Job*>& deferred) noexcept
+    {
+        if(deferred.empty())
+        {
+            return;
+        }
+
+        std::reverse(deferred.begin(), deferred.end());
+
+        setJobsPushed(queue, deferred);
+
+        deferred.clear();
+    }
+
+    void
+    setJobThreadPinned(const u16 core) noexcept
+    {
+#if defined(__linux__)
+        auto cores = cpu_set_t {};
+
+        CPU_ZERO(&cores);
+        CPU_SET(core % CPU_SETSIZE, &cores);
+
+        pthread_setaffinity_np(pthread_self(), sizeof(cores), &cores);
+#endif
+    }
+
+    void
+    setJobWorker(JobQueue& queue, const u16 threadIndex, const std::stop_token stop) noexcept
+    {
+        s_jobQueue       = &queue;
+        s_jobThreadIndex = threadIndex;
+
+        setJobThreadPinned(threadIndex);
+
+        while(!stop.stop_requested())
+        {
+            const auto generation = queue.generation.load(std::memory_order_acquire);
+
+            if(const auto job = getJobNext(queue, threadIndex))
+            {
+                setJobRun(queue, *job);
+
+                continue;
+            }
+
+            auto lock = std::unique_lock {queue.mutex};
+
+            if(!queue.condition.wait(lock,
+                                     stop,
+                                     [&queue, generation]()
+                                     {
+                                         return queue.generation.load(std::memory_order_relaxed) != generation;
+                                     }))
+            {
+                return;
+            }
+        }
+    }
+
+    JobSystem
+    getJobSystem(const u16 workerCount) noexcept
+    {
+        ND_SET_SCOPE();
+
+        auto system = JobSystem {.queue = std::make_unique<JobQueue>(), .workers = {}};
+
+        system.queue->deques      = std::make_unique<JobDeque[]>(workerCount + 1);
+        system.queue->threadCount = workerCount + 1;
+
+        s_jobQueue       = system.queue.get();
+        s_jobThreadIndex = 0;
+
+        for(u16 threadIndex = 1; threadIndex <= workerCount; ++threadIndex)
+        {
+            system.workers.emplace_back(
+                [queue = system.queue.get(), threadIndex](const std::stop_token stop)
+                {
+                    setJobWorker(*queue, threadIndex, stop);
+                });
+        }
+
+        return system;
+    }
+
+    u16
+    getJobThreadIndex() noexcept
+    {
+        return s_jobThreadIndex;
+    }
+
+    void
+    setJobs(JobSystem&         system,
+            JobCounter&        counter,
+            const u64          count,
+            const u64          batch,
+            const JobFunction& function,
+            JobCounter*        dependency) noexcept(ND_ASSERT_NOTHROW)
+    {
+        ND_SET_SCOPE();
+
+        // checked in every build, only the owner may push onto its deque
+        if(s_jobQueue != system.queue.get())
+        {
+            std::terminate();
+        }
+
+        ND_ASSERT(batch != 0);
+
+        auto jobs = vec<Job*> {};
+
+        {
+            const auto lock = std::lock_guard {counter.mutex};
+
+            if(counter.pending == 0)
+            {
+                counter.jobs.clear();
+            }
+
+            for(u64 first = 0; first < count; first += batch)
+            {
+                counter.jobs.push_back({.function = &function, .counter = &counter, .first = first, .last = std::min(first + batch, count)});
+
+                jobs.push_back(&counter.jobs.back());
+            }
+
+            counter.pending += jobs.size();
+        }
+
+        if(dependency)
+        {
+            const auto lock = std::lock_guard {dependency->mutex};
+
+            if(dependency->pending != 0)
+            {
+                dependency->waiting.insert(dependency->waiting.end(), jobs.begin(), jobs.end());
+
+                return;
+            }
+        }
+
+        setJobsPushed(*system.queue, jobs);
+    }
+
+    bool
+    isJobCounterDone(JobCounter& counter) noexcept
+    {
+        const auto lock = std::lock_guard {counter.mutex};
+
+        return counter.pending == 0;
+    }
+
+    void
+    setJobsWait(JobSystem& system, JobCounter& counter) noexcept
+    {
+        ND_SET_SCOPE();
+
+        if(s_jobQueue != system.queue.get())
+        {
+            std::terminate();
+        }
+
+        auto& queue = *system.queue;
+
+        auto deferred = vec<Job*> {};
+        auto drained  = false;
+        auto misses   = 0U;
+
+        while(true)
+        {
+            const auto generation = queue.generation.load(std::memory_order_acquire);
+
+            if(isJobCounterDone(counter))
+            {
+                break;
+            }
+
+            if(!drained)
+            {
+                if(const auto job = getJobPopped(queue.deques[s_jobThreadIndex]))
+                {
+                    if(job->counter == &counter)
+                    {
+                        setJobRun(queue, *job);
+                    }
+                    else
+                    {
+                        deferred.push_back(job);
+                    }
+
+                    continue;
+                }
+
+                setJobsDeferred(queue, deferred);
+
+                drained = true;
+            }
+
+            if(const auto job = getJobWaited(queue, s_jobThreadIndex))
+            {
+                setJobRun(queue, *job);
+
+                misses = 0;
+
+                continue;
+            }
+
+            if(++misses < jobWaitSpinMax)
+            {
+                std::this_thread::yield();
+
+                continue;
+            }
+
+            auto lock = std::unique_lock {queue.mutex};
+
+            queue.condition.wait(lock,
+                                 [&queue, generation]()
+                                 {
+                                     return queue.generation.load(std::memory_order_relaxed) != generation;
+                                 });
+
+            misses = 0;
+        }
+
+        setJobsDeferred(queue, deferred);
+    }
+} // namespace nd::src::tools
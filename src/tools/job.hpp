@@ -0,0 +1,77 @@
+#pragma once
+
+#include "pch.hpp"
+
+#include "tools.hpp"
+
+namespace nd::src::tools
+{
+    // Work-stealing jobs on pinned threads, the creating thread is thread zero and only threads of the system submit or wait
+
+    using JobFunction = func<void(const u64, const u64)>;
+
+    struct JobCounter;
+
+    struct Job final
+    {
+        const JobFunction* function;
+        JobCounter*        counter;
+
+        u64 first;
+        u64 last;
+    };
+
+    struct JobCounter final
+    {
+        std::mutex mutex;
+
+        u64 pending = {};
+
+        std::deque<Job> jobs;
+
+        vec<Job*> waiting;
+    };
+
+    constexpr auto jobDequeCapacity = u64 {4096};
+
+    struct JobDeque final
+    {
+        alignas(64) std::atomic<i64> top;
+        alignas(64) std::atomic<i64> bottom;
+
+        array<std::atomic<Job*>, jobDequeCapacity> jobs;
+    };
+
+    struct JobQueue final
+    {
+        std::mutex                  mutex;
+        std::condition_variable_any condition;
+
+        std::atomic<u64> generation;
+
+        unique<JobDeque[]> deques;
+        u16                threadCount;
+    };
+
+    struct JobSystem final
+    {
+        unique<JobQueue> queue;
+
+        vec<std::jthread> workers;
+    };
+
+    JobSystem
+    getJobSystem(const u16) noexcept;
+
+    u16
+    getJobThreadIndex() noexcept;
+
+    void
+    setJobs(JobSystem&, JobCounter&, const u64, const u64, const JobFunction&, JobCounter* = nullptr) noexcept(ND_ASSERT_NOTHROW);
+
+    bool
+    isJobCounterDone(JobCounter&) noexcept;
+
+    void
+    setJobsWait(JobSystem&, JobCounter&) noexcept;
+} // namespace nd::src::tools
@@ -32,6 +32,8 @@
 #include <algorithm>
 #include <functional>
 #include <numbers>
+#include <limits>
+#include <bit>
 
 #include <atomic>
 #include <condition_variable>
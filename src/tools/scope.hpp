@@ -24,8 +24,8 @@ namespace nd::src::tools
         }
 
     private:
-        static shared<logger> s_logPtr;
-        static u64            s_depth;
+        static shared<logger>   s_logPtr;
+        static thread_local u64 s_depth;
 
         const Event onEnd_ {};
         const str_v name_ {};